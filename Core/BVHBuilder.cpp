@@ -0,0 +1,361 @@
+/**
+  ******************************************************************************
+  * @file           : BVHBuilder.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-20
+  ******************************************************************************
+  */
+
+
+
+#include <Core/BVHBuilder.h>
+#include <Core/Parallel.h>
+#include <Core/Debug.h>
+
+namespace
+{
+
+// Beyond This Depth Split By Count Only, Which Bounds The Depth By MAX_SAH_DEPTH + log2(N).
+CONSTEXPR Eigen::Index MAX_SAH_DEPTH = 32;
+
+// Nodes With At Least This Many Primitives Compute Bounds And Bins With Parallel::For.
+CONSTEXPR Eigen::Index PARALLEL_BINNING_THRESHOLD = 1 << 16;
+
+// Subtrees Smaller Than This Are Built By A Single Task.
+CONSTEXPR Eigen::Index MIN_TASK_SIZE = 1 << 12;
+
+struct Bin
+{
+    Eigen::Vector3d bmin = Eigen::Vector3d::Constant(INF);
+    Eigen::Vector3d bmax = Eigen::Vector3d::Constant(-INF);
+    Eigen::Index count = 0;
+
+    FORCE_INLINE void Merge(const Bin& oth) NOEXCEPT
+    {
+        bmin = bmin.cwiseMin(oth.bmin);
+        bmax = bmax.cwiseMax(oth.bmax);
+        count += oth.count;
+    }
+};
+
+struct Bounds
+{
+    Eigen::Vector3d bmin = Eigen::Vector3d::Constant(INF);
+    Eigen::Vector3d bmax = Eigen::Vector3d::Constant(-INF);
+    Eigen::Vector3d cmin = Eigen::Vector3d::Constant(INF);
+    Eigen::Vector3d cmax = Eigen::Vector3d::Constant(-INF);
+
+    FORCE_INLINE void Merge(const BVHBuilder::Primitive& primitive) NOEXCEPT
+    {
+        bmin = bmin.cwiseMin(primitive.bmin);
+        bmax = bmax.cwiseMax(primitive.bmax);
+        cmin = cmin.cwiseMin(primitive.center);
+        cmax = cmax.cwiseMax(primitive.center);
+    }
+
+    FORCE_INLINE void Merge(const Bounds& oth) NOEXCEPT
+    {
+        bmin = bmin.cwiseMin(oth.bmin);
+        bmax = bmax.cwiseMax(oth.bmax);
+        cmin = cmin.cwiseMin(oth.cmin);
+        cmax = cmax.cwiseMax(oth.cmax);
+    }
+};
+
+// Runs work(thread_begin, thread_end, local) Over [begin, end) And Merges Each Local Result Into result.
+template<typename T, typename Work>
+void Reduce(const Eigen::Index begin, const Eigen::Index end, const bool parallel, const T& identity, T& result, Work&& work) NOEXCEPT
+{
+    if (!parallel)
+    {
+        work((size_t)begin, (size_t)end, result);
+        return;
+    }
+
+    std::mutex mutex;
+    Parallel::For((size_t)begin, (size_t)end, THREAD_POOL.ThreadNumber(),
+        [&mutex, &identity, &result, &work](size_t thread_begin, size_t thread_end)
+        {
+            T local = identity;
+            work(thread_begin, thread_end, local);
+            std::unique_lock lock(mutex);
+            result.Merge(local);
+        }
+    );
+}
+
+struct BinArray
+{
+    std::vector<Bin> bins;
+
+    FORCE_INLINE void Merge(const BinArray& oth) NOEXCEPT
+    {
+        for (size_t i = 0; i < bins.size(); ++i)
+        {
+            bins[i].Merge(oth.bins[i]);
+        }
+    }
+};
+
+// Fills The Bounds Of node And Splits [begin, end). Returns The Split Position, Or end If node Becomes A Leaf.
+// NOTE: Only The Calling Thread May Use Parallel::For. Tasks Running On THREAD_POOL Must Pass allow_parallel = false.
+NODISCARD Eigen::Index Split(std::vector<BVHBuilder::Primitive>& primitives, const Eigen::Index begin, const Eigen::Index end, const BVHConfig& config, const Eigen::Index depth, const bool allow_parallel, BVHBuildNode& node) NOEXCEPT
+{
+    ASSERT(begin < end);
+
+    const Eigen::Index count = end - begin;
+    const bool parallel = allow_parallel && count >= PARALLEL_BINNING_THRESHOLD;
+
+    Bounds bounds;
+    Reduce(begin, end, parallel, Bounds{}, bounds,
+        [&primitives](const size_t thread_begin, const size_t thread_end, Bounds& local)
+        {
+            for (size_t i = thread_begin; i < thread_end; ++i)
+            {
+                local.Merge(primitives[i]);
+            }
+        }
+    );
+
+    node.bmin = bounds.bmin;
+    node.bmax = bounds.bmax;
+    node.axis = 0;
+    node.begin = begin;
+    node.count = count;
+
+    if (count == 1)
+    {
+        return end;
+    }
+
+    Eigen::Index axis;
+    const double extent = (bounds.cmax - bounds.cmin).maxCoeff(&axis);
+    node.axis = axis;
+
+    Eigen::Index mid = begin;
+
+    if (extent > 0.0 && depth < MAX_SAH_DEPTH)
+    {
+        const Eigen::Index bin_count = std::max<Eigen::Index>(config.bin_count, 2);
+        const double scale = (double)bin_count / extent;
+        const double cmin = bounds.cmin[axis];
+        const auto bin_of = [cmin, axis, bin_count, scale](const BVHBuilder::Primitive& primitive) -> Eigen::Index
+        {
+            return std::min((Eigen::Index)((primitive.center[axis] - cmin) * scale), bin_count - 1);
+        };
+
+        const BinArray empty{ std::vector<Bin>(bin_count) };
+        BinArray t_bins = empty;
+        Reduce(begin, end, parallel, empty, t_bins,
+            [&primitives, &bin_of](const size_t thread_begin, const size_t thread_end, BinArray& local)
+            {
+                for (size_t i = thread_begin; i < thread_end; ++i)
+                {
+                    Bin& bin = local.bins[bin_of(primitives[i])];
+                    bin.bmin = bin.bmin.cwiseMin(primitives[i].bmin);
+                    bin.bmax = bin.bmax.cwiseMax(primitives[i].bmax);
+                    ++bin.count;
+                }
+            }
+        );
+        const std::vector<Bin>& bins = t_bins.bins;
+
+        // Sweep From The Right, Then From The Left. Split k Puts Bins [0, k] On The Left.
+        std::vector<double> right_area(bin_count);
+        std::vector<Eigen::Index> right_count(bin_count);
+        Bin acc;
+        for (Eigen::Index k = bin_count - 1; k > 0; --k)
+        {
+            acc.Merge(bins[k]);
+            right_area[k - 1] = BVHBuilder::SurfaceArea(acc.bmin, acc.bmax);
+            right_count[k - 1] = acc.count;
+        }
+
+        const double area = BVHBuilder::SurfaceArea(node.bmin, node.bmax);
+        const double inv_area = area > 0.0 ? 1.0 / area : 0.0;
+
+        double best_cost = INF;
+        Eigen::Index best_split = -1;
+        acc = Bin{};
+        for (Eigen::Index k = 0; k < bin_count - 1; ++k)
+        {
+            acc.Merge(bins[k]);
+            if (acc.count == 0 || right_count[k] == 0) { continue; }
+            const double cost = config.traversal_cost + config.intersection_cost * inv_area *
+                ((double)acc.count * BVHBuilder::SurfaceArea(acc.bmin, acc.bmax) + (double)right_count[k] * right_area[k]);
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_split = k;
+            }
+        }
+
+        const double leaf_cost = config.intersection_cost * (double)count;
+        if (count <= config.max_leaf_size && leaf_cost <= best_cost)
+        {
+            return end;
+        }
+
+        if (best_split >= 0)
+        {
+            mid = std::partition(primitives.begin() + begin, primitives.begin() + end,
+                [&bin_of, best_split](const BVHBuilder::Primitive& primitive) -> bool
+                {
+                    return bin_of(primitive) <= best_split;
+                }
+            ) - primitives.begin();
+        }
+    }
+    else if (count <= config.max_leaf_size)
+    {
+        return end;
+    }
+
+    // Fallback: Coincident Centroids, Too Deep Or No Valid Bin Split, Halve By Count.
+    if (mid == begin || mid == end)
+    {
+        mid = (begin + end) / 2;
+        std::nth_element(primitives.begin() + begin, primitives.begin() + mid, primitives.begin() + end,
+            [axis](const BVHBuilder::Primitive& lhs, const BVHBuilder::Primitive& rhs) -> bool
+            {
+                return lhs.center[axis] < rhs.center[axis];
+            }
+        );
+    }
+
+    node.count = 0;
+    return mid;
+}
+
+void BuildRecursive(std::vector<BVHBuilder::Primitive>& primitives, const Eigen::Index begin, const Eigen::Index end, const BVHConfig& config, const Eigen::Index depth, BVHBuildNode& node) NOEXCEPT // NOLINT(*-no-recursion)
+{
+    const Eigen::Index mid = Split(primitives, begin, end, config, depth, false, node);
+    if (mid == end) { return; }
+
+    node.children[0] = MakeUni<BVHBuildNode>();
+    node.children[1] = MakeUni<BVHBuildNode>();
+    BuildRecursive(primitives, begin, mid, config, depth + 1, *node.children[0]);
+    BuildRecursive(primitives, mid, end, config, depth + 1, *node.children[1]);
+}
+
+void StatisticsRecursive(const BVHBuildNode& node, const BVHConfig& config, const Eigen::Index depth, const double inv_root_area, BVHStatistics& statistics) NOEXCEPT // NOLINT(*-no-recursion)
+{
+    const double probability = BVHBuilder::SurfaceArea(node.bmin, node.bmax) * inv_root_area;
+
+    ++statistics.node_count;
+    statistics.max_depth = std::max(statistics.max_depth, depth);
+
+    if (node.IsLeaf())
+    {
+        ++statistics.leaf_count;
+        statistics.sah_cost += probability * config.intersection_cost * (double)node.count;
+        return;
+    }
+
+    statistics.sah_cost += probability * config.traversal_cost;
+    StatisticsRecursive(*node.children[0], config, depth + 1, inv_root_area, statistics);
+    StatisticsRecursive(*node.children[1], config, depth + 1, inv_root_area, statistics);
+}
+
+}
+
+NODISCARD BVHBuilder::Result BVHBuilder::Build(std::vector<Primitive>& primitives, const BVHConfig& config) NOEXCEPT
+{
+    Result result;
+
+    if (primitives.empty()) UNLIKELY
+    {
+        return result;
+    }
+
+    const auto st = Debug::Now();
+
+    const Eigen::Index primitive_count = (Eigen::Index)primitives.size();
+    result.root = MakeUni<BVHBuildNode>();
+
+    // Split The Top Levels On This Thread (Binning In Parallel) Until Subtrees Are Small Enough,
+    // Then Build Each Subtree As One Task. Tasks Never Wait On The Pool, So This Cannot Deadlock.
+    struct Task
+    {
+        BVHBuildNode* node;
+        Eigen::Index begin;
+        Eigen::Index end;
+        Eigen::Index depth;
+    };
+
+    const Eigen::Index task_size = std::max<Eigen::Index>(primitive_count / (Eigen::Index)(8 * THREAD_POOL.ThreadNumber()), MIN_TASK_SIZE);
+    std::vector<Task> tasks;
+    std::queue<Task> queue;
+    queue.push(Task{ result.root.get(), 0, primitive_count, 1 });
+
+    while (!queue.empty())
+    {
+        const Task task = queue.front();
+        queue.pop();
+
+        if (task.end - task.begin < task_size)
+        {
+            tasks.push_back(task);
+            continue;
+        }
+
+        const Eigen::Index mid = Split(primitives, task.begin, task.end, config, task.depth, true, *task.node);
+        if (mid == task.end) { continue; }
+
+        task.node->children[0] = MakeUni<BVHBuildNode>();
+        task.node->children[1] = MakeUni<BVHBuildNode>();
+        queue.push(Task{ task.node->children[0].get(), task.begin, mid, task.depth + 1 });
+        queue.push(Task{ task.node->children[1].get(), mid, task.end, task.depth + 1 });
+    }
+
+    if (tasks.size() == 1)
+    {
+        BuildRecursive(primitives, tasks[0].begin, tasks[0].end, config, tasks[0].depth, *tasks[0].node);
+    }
+    else
+    {
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasks.size());
+        for (const Task& task : tasks)
+        {
+            futures.push_back(THREAD_POOL.Submit([&primitives, &config, task]() -> void
+            {
+                BuildRecursive(primitives, task.begin, task.end, config, task.depth, *task.node);
+            }));
+        }
+        for (auto& future : futures)
+        {
+            future.wait();
+        }
+    }
+
+    result.order.resize(primitives.size());
+    Parallel::For(0, primitives.size(), THREAD_POOL.ThreadNumber(),
+        [&result, &primitives](size_t thread_begin, size_t thread_end)
+        {
+            for (size_t i = thread_begin; i < thread_end; ++i)
+            {
+                result.order[i] = primitives[i].index;
+            }
+        }
+    );
+
+    result.statistics = Statistics(*result.root, config);
+    result.statistics.primitive_count = primitive_count;
+    result.statistics.reference_count = primitive_count;
+
+    const auto ed = Debug::Now();
+    result.statistics.build_time = Debug::MicroSeconds(ed - st);
+
+    return result;
+}
+
+NODISCARD BVHStatistics BVHBuilder::Statistics(const BVHBuildNode& root, const BVHConfig& config) NOEXCEPT
+{
+    BVHStatistics statistics;
+    const double root_area = SurfaceArea(root.bmin, root.bmax);
+    StatisticsRecursive(root, config, 1, root_area > 0.0 ? 1.0 / root_area : 0.0, statistics);
+    return statistics;
+}
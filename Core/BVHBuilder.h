@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file           : BVHBuilder.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-20
+  ******************************************************************************
+  */
+
+
+
+#ifndef BVH_BUILDER_H
+#define BVH_BUILDER_H
+
+#include <Core/Common.h>
+
+struct BVHConfig
+{
+    enum BVHLayout
+    {
+        BVH_LAYOUT_BINARY,
+        BVH_LAYOUT_WIDE4,
+        BVH_LAYOUT_WIDE8,
+        BVH_LAYOUT_QUANTIZED8,  // BVH_LAYOUT_WIDE8 With 8 Bit Child Bounds.
+        BVH_LAYOUT_QUANTIZED16, // BVH_LAYOUT_WIDE8 With 16 Bit Child Bounds.
+    };
+
+    BVHLayout layout = BVH_LAYOUT_BINARY;
+    Eigen::Index bin_count = 16;
+    Eigen::Index max_leaf_size = 4;
+    double traversal_cost = 1.0;
+    double intersection_cost = 1.0;
+    double rebuild_threshold = 1.5;    // Refit Gives Up Once The SAH Cost Grows By This Factor.
+    bool spatial_splits = false;       // See SBVHBuilder.
+    double spatial_split_alpha = 1e-5; // Try Spatial Splits Only Where Child Overlap Exceeds This Fraction Of The Root Area.
+    double spatial_split_budget = 0.3; // Extra References Allowed, As A Fraction Of The Primitive Count.
+    bool treelet_optimization = false; // See TreeletOptimizer.
+    Eigen::Index treelet_size = 7;     // Leaves Per Treelet, At Most 8.
+    Eigen::Index treelet_passes = 3;
+    bool precompute_edges = false;     // Mesh Only: Faster Triangle Tests For 36 (Float) Or 72 (Double) More Bytes Per Triangle, See Mesh::Edges.
+};
+
+struct BVHStatistics
+{
+    Eigen::Index node_count = 0;
+    Eigen::Index leaf_count = 0;
+    Eigen::Index max_depth = 0;
+    Eigen::Index primitive_count = 0;
+    Eigen::Index reference_count = 0; // Exceeds primitive_count Once Spatial Splits Duplicate References.
+    double sah_cost = 0.0;
+    size_t build_time = 0;             // Microseconds.
+    double unoptimized_sah_cost = 0.0; // TreeletOptimizer Only: sah_cost As Built.
+    size_t optimize_time = 0;          // TreeletOptimizer Only: Microseconds, Not Part Of build_time.
+};
+
+struct BVHBuildNode
+{
+    Eigen::Vector3d bmin;
+    Eigen::Vector3d bmax;
+    Uni<BVHBuildNode> children[2];
+    Eigen::Index axis;       // Interior Node: Split Axis.
+    Eigen::Index begin;      // Leaf Node: First Primitive In Order.
+    Eigen::Index count;      // Leaf Node: Number Of Primitives. Zero For Interior Node.
+    double cost = 0.0;       // TreeletOptimizer Scratch: SAH Cost Of The Subtree, Not Normalized.
+    Eigen::Index height = 0; // TreeletOptimizer Scratch: Levels In The Subtree.
+
+    NODISCARD FORCE_INLINE bool IsLeaf() const NOEXCEPT { return count > 0; }
+};
+
+// Binned SAH Builder. Ref: https://www.pbr-book.org/3ed-2018/Primitives_and_Intersection_Acceleration/Bounding_Volume_Hierarchies
+struct BVHBuilder
+{
+    struct Primitive
+    {
+        Eigen::Vector3d bmin;
+        Eigen::Vector3d bmax;
+        Eigen::Vector3d center;
+        Eigen::Index index;
+    };
+
+    struct Result
+    {
+        Uni<BVHBuildNode> root;
+        std::vector<Eigen::Index> order; // Leaf Ranges Index Into This. Values Are Primitive::index.
+        BVHStatistics statistics;
+    };
+
+    NODISCARD FORCE_INLINE static double SurfaceArea(const Eigen::Vector3d& bmin, const Eigen::Vector3d& bmax) NOEXCEPT
+    {
+        const Eigen::Vector3d d = (bmax - bmin).cwiseMax(0.0);
+        return 2.0 * (d.x() * d.y() + d.y() * d.z() + d.z() * d.x());
+    }
+
+    FORCE_INLINE static void RangeBounds(const std::vector<Primitive>& primitives, const Eigen::Index begin, const Eigen::Index end, Eigen::Vector3d& bmin, Eigen::Vector3d& bmax) NOEXCEPT
+    {
+        bmin = Eigen::Vector3d::Constant(INF);
+        bmax = Eigen::Vector3d::Constant(-INF);
+        for (Eigen::Index i = begin; i < end; ++i)
+        {
+            bmin = bmin.cwiseMin(primitives[i].bmin);
+            bmax = bmax.cwiseMax(primitives[i].bmax);
+        }
+    }
+
+    NODISCARD static Result Build(std::vector<Primitive>& primitives, const BVHConfig& config) NOEXCEPT;
+
+    NODISCARD static BVHStatistics Statistics(const BVHBuildNode& root, const BVHConfig& config) NOEXCEPT;
+};
+
+#endif //BVH_BUILDER_H
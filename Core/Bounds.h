@@ -17,79 +17,63 @@
 #include <Core/Ray.h>
 #include <Core/Interval.h>
 
-struct BoundingBox
+// Plain Value, Embedded In Hittables. Default Constructed Boxes Are Empty.
+struct AABB
 {
-protected:
-    enum BoundingBoxKind
-    {
-        BOUNDING_BOX_KIND_AABB,
-        BOUNDING_BOX_KIND_BVH,
-    };
-
-private:
-    const BoundingBoxKind kind;
-
-public:
-    NODISCARD CONSTEXPR FORCE_INLINE BoundingBoxKind Kind() const NOEXCEPT { return kind; }
+    Vector3r bmin = Vector3r::Constant(INF);
+    Vector3r bmax = Vector3r::Constant(-INF);
 
-    NODISCARD virtual Eigen::Vector3d Center() const NOEXCEPT = 0;
-    NODISCARD virtual bool Hit(const Ray& ray, const Interval& interval) const NOEXCEPT = 0;
-
-    NODISCARD explicit BoundingBox(const BoundingBoxKind kind) NOEXCEPT : kind(kind) {}
-    virtual ~BoundingBox() NOEXCEPT = default;
-};
+    NODISCARD AABB() NOEXCEPT = default;
 
-struct AABB final : BoundingBox
-{
-    NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const BoundingBox* ptr) NOEXCEPT {return ptr->Kind() == BOUNDING_BOX_KIND_AABB;}
-
-    Interval xi, yi, zi;
-
-    NODISCARD AABB() NOEXCEPT
-    : BoundingBox(BOUNDING_BOX_KIND_AABB)
-    {}
-
-    NODISCARD AABB(const Interval& x_interval, const Interval& y_interval, const Interval& z_interval) NOEXCEPT
-    : BoundingBox(BOUNDING_BOX_KIND_AABB), xi(x_interval), yi(y_interval), zi(z_interval)
-    {}
-
-    NODISCARD AABB(const Eigen::Vector3d& a, const Eigen::Vector3d& b) NOEXCEPT
-    : BoundingBox(BOUNDING_BOX_KIND_AABB)
+    // Any Two Opposite Corners. Flat Axes Are Padded So That Planar Primitives Still Have Volume.
+    NODISCARD AABB(const Vector3r& a, const Vector3r& b) NOEXCEPT
+    : bmin(a.cwiseMin(b)), bmax(a.cwiseMax(b))
     {
-        xi = (a.x() < b.x()) ? Interval{a.x(), b.x()} : Interval{b.x(), a.x()};
-        yi = (a.y() < b.y()) ? Interval{a.y(), b.y()} : Interval{b.y(), a.y()};
-        zi = (a.z() < b.z()) ? Interval{a.z(), b.z()} : Interval{b.z(), a.z()};
-
-        CONSTEXPR double delta = 0.0001;
-        if (xi.IsEmpty()) { xi = xi.Expand(delta); }
-        if (yi.IsEmpty()) { yi = yi.Expand(delta); }
-        if (zi.IsEmpty()) { zi = zi.Expand(delta); }
+        CONSTEXPR Real delta = (Real)0.0001;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (Fge(bmin[i], bmax[i])) { bmin[i] -= delta; bmax[i] += delta; }
+        }
     }
 
     NODISCARD AABB(const AABB& a, const AABB& b) NOEXCEPT
-    : BoundingBox(BOUNDING_BOX_KIND_AABB),
-      xi(Interval::Union(a.xi, b.xi)),
-      yi(Interval::Union(a.yi, b.yi)),
-      zi(Interval::Union(a.zi, b.zi))
+    : bmin(a.bmin.cwiseMin(b.bmin)), bmax(a.bmax.cwiseMax(b.bmax))
     {}
 
-    NODISCARD Eigen::Vector3d Center() const NOEXCEPT OVERRIDE
+    NODISCARD FORCE_INLINE bool IsEmpty() const NOEXCEPT
     {
-        return { xi.Center(), yi.Center(), zi.Center() };
+        return (bmin.array() > bmax.array()).any();
     }
 
-    NODISCARD bool Hit(const Ray &ray, const Interval &interval) const NOEXCEPT OVERRIDE
+    NODISCARD FORCE_INLINE Vector3r Center() const NOEXCEPT
     {
-        const double inv_dx = 1.0 / ray.direction.x();
-        const double inv_dy = 1.0 / ray.direction.y();
-        const double inv_dz = 1.0 / ray.direction.z();
+        return (bmin + bmax) / 2.0;
+    }
 
-        const Interval hxi = Interval((xi.imin - ray.origin.x()) * inv_dx, (xi.imax - ray.origin.x()) * inv_dx);
-        const Interval hyi = Interval((yi.imin - ray.origin.y()) * inv_dy, (yi.imax - ray.origin.y()) * inv_dy);
-        const Interval hzi = Interval((zi.imin - ray.origin.z()) * inv_dz, (zi.imax - ray.origin.z()) * inv_dz);
-        const Interval hi = Interval::Intersection(Interval::Intersection(hxi, hyi), Interval::Intersection(hzi, interval));
+    NODISCARD FORCE_INLINE bool Hit(const Ray& ray, const Interval& interval) const NOEXCEPT
+    {
+        Real t_entry;
+        return Hit(bmin, bmax, ray, interval, t_entry);
+    }
 
-        return !hi.IsEmpty();
+    // Slab Test Shared By The BVH Nodes, BOUND Is Anything Indexable By Axis (Vector3r, float[3]).
+    // The Sign Picks The Near Plane Without Swapping. A Zero Direction Component Gives +-INF Outside The Slab,
+    // And NaN (0 * INF) When The Origin Lies On A Plane, Which std::max/std::min Drop By Their Operand Order.
+    template<typename BOUND>
+    NODISCARD FORCE_INLINE static bool Hit(const BOUND& bmin, const BOUND& bmax, const Ray& ray, const Interval& interval, Real& t_entry) NOEXCEPT
+    {
+        Real t0 = interval.imin, t1 = interval.imax;
+        for (int a = 0; a < 3; ++a)
+        {
+            const Real lo = (Real)bmin[a];
+            const Real hi = (Real)bmax[a];
+            const Real t_near = ((ray.sign[a] ? hi : lo) - ray.origin[a]) * ray.inv_direction[a];
+            const Real t_far = ((ray.sign[a] ? lo : hi) - ray.origin[a]) * ray.inv_direction[a];
+            t0 = std::max(t0, t_near);
+            t1 = std::min(t1, t_far);
+        }
+        t_entry = t0;
+        return t0 <= t1;
     }
 };
 
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file           : Buffer.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-29
+  ******************************************************************************
+  */
+
+
+
+#ifndef BUFFER_H
+#define BUFFER_H
+
+#include <Core/Common.h>
+#include <Core/MappedFile.h>
+
+// Array That Either Owns Its Elements Or Views Plain Data Elements Inside A MappedFile.
+// Element Writes Go Straight To The Mapping (Copy On Write), Anything That Changes The Size Copies Into Owned Storage First.
+template<typename T>
+struct Buffer
+{
+    // NOTE: Eigen Fixed Size Vectors Are Not Trivially Copyable By The Standard But Are Plain Data In Memory.
+    static_assert(std::is_standard_layout_v<T> && std::is_trivially_destructible_v<T>);
+
+    std::vector<T> storage;
+    Ref<MappedFile> mapping; // Keeps The View Alive. nullptr For Owned Storage.
+    T* view = nullptr;
+    size_t count = 0;
+
+    NODISCARD Buffer() NOEXCEPT = default;
+
+    NODISCARD Buffer(std::vector<T>&& data) NOEXCEPT : storage(std::move(data)) {} // NOLINT(*-explicit-constructor)
+
+    // The Caller Checks That [offset, offset + count * sizeof(T)) Lies In The File And Is Aligned For T.
+    NODISCARD Buffer(const Ref<MappedFile>& mapped, const size_t offset, const size_t n) NOEXCEPT
+        : mapping(mapped), view(n == 0 ? nullptr : (T*)(mapped->Bytes() + offset)), count(n)
+    {
+        ASSERT((offset + n * sizeof(T)) <= mapped->size && (uintptr_t)view % alignof(T) == 0);
+    }
+
+    NODISCARD Buffer(const Buffer& other) NOEXCEPT : storage(other.begin(), other.end()) {}
+
+    NODISCARD Buffer(Buffer&& other) NOEXCEPT = default;
+
+    Buffer& operator=(const Buffer& other) NOEXCEPT
+    {
+        if (this != &other)
+        {
+            std::vector<T> t_storage(other.begin(), other.end());
+            *this = Buffer(std::move(t_storage));
+        }
+        return *this;
+    }
+
+    Buffer& operator=(Buffer&& other) NOEXCEPT = default;
+
+    Buffer& operator=(std::vector<T>&& data) NOEXCEPT
+    {
+        return *this = Buffer(std::move(data));
+    }
+
+    NODISCARD FORCE_INLINE bool IsMapped() const NOEXCEPT { return mapping != nullptr; }
+
+    NODISCARD FORCE_INLINE size_t size() const NOEXCEPT { return IsMapped() ? count : storage.size(); }
+    NODISCARD FORCE_INLINE bool empty() const NOEXCEPT { return size() == 0; }
+
+    NODISCARD FORCE_INLINE const T* data() const NOEXCEPT { return IsMapped() ? view : storage.data(); }
+    NODISCARD FORCE_INLINE T* data() NOEXCEPT { return IsMapped() ? view : storage.data(); }
+
+    NODISCARD FORCE_INLINE const T& operator[](const size_t i) const NOEXCEPT { return data()[i]; }
+    NODISCARD FORCE_INLINE T& operator[](const size_t i) NOEXCEPT { return data()[i]; }
+
+    NODISCARD FORCE_INLINE const T* begin() const NOEXCEPT { return data(); }
+    NODISCARD FORCE_INLINE const T* end() const NOEXCEPT { return data() + size(); }
+    NODISCARD FORCE_INLINE T* begin() NOEXCEPT { return data(); }
+    NODISCARD FORCE_INLINE T* end() NOEXCEPT { return data() + size(); }
+
+    void resize(const size_t n) NOEXCEPT { Own(); storage.resize(n); }
+    void reserve(const size_t n) NOEXCEPT { Own(); storage.reserve(n); }
+    void push_back(const T& value) NOEXCEPT { Own(); storage.push_back(value); }
+    void clear() NOEXCEPT { *this = Buffer(); }
+
+    void Own() NOEXCEPT
+    {
+        if (!IsMapped()) { return; }
+        storage.assign(view, view + count);
+        mapping = nullptr;
+        view = nullptr;
+        count = 0;
+    }
+};
+
+#endif //BUFFER_H
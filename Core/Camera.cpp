@@ -45,7 +45,7 @@ NODISCARD Camera Camera::FromXML(const char* filename) NOEXCEPT
     const char* xml_width = xml_camera->Attribute("width");                           ASSERT(xml_width != nullptr);
     const char* xml_fovy = xml_camera->Attribute("fovy");                             ASSERT(xml_fovy != nullptr);
 
-    std::unordered_map<std::string, Ref<Texture2D<Eigen::Vector3d>>> lights;
+    std::unordered_map<std::string, Ref<Texture2D<Vector3r>>> lights;
     for (tinyxml2::XMLElement* e = doc.FirstChildElement("light"); e; e = e->NextSiblingElement("light"))
     {
         double x, y, z;
@@ -59,49 +59,49 @@ NODISCARD Camera Camera::FromXML(const char* filename) NOEXCEPT
         #ifdef _MSC_VER
         #pragma warning(pop)
         #endif
-        lights[e->Attribute("mtlname")] = MakeRef<PureColorTexture2D>(Eigen::Vector3d{x, y, z});
+        lights[e->Attribute("mtlname")] = MakeRef<PureColorTexture2D>(Eigen::Vector3d{x, y, z}.cast<Real>());
     }
 
     // #ifndef NDEBUG
     // for (const auto &each: lights | std::views::values)
     // {
-    //     Debug::Dump(stdout, each->Sample(Eigen::Vector2d{0.0, 0.0}));
+    //     Debug::Dump(stdout, each->Sample(Vector2r{0.0, 0.0}));
     //     fflush(stdout);
     // }
     // #endif
 
-    Eigen::Vector3d eye = Eigen::Vector3d
+    Vector3r eye = Vector3r
     {
-        (double)std::strtold(xml_eye->Attribute("x"), nullptr),
-        (double)std::strtold(xml_eye->Attribute("y"), nullptr),
-        (double)std::strtold(xml_eye->Attribute("z"), nullptr),
+        (Real)std::strtold(xml_eye->Attribute("x"), nullptr),
+        (Real)std::strtold(xml_eye->Attribute("y"), nullptr),
+        (Real)std::strtold(xml_eye->Attribute("z"), nullptr),
     };
 
-    Eigen::Vector3d lookat = Eigen::Vector3d
+    Vector3r lookat = Vector3r
     {
-        (double)std::strtold(xml_lookat->Attribute("x"), nullptr),
-        (double)std::strtold(xml_lookat->Attribute("y"), nullptr),
-        (double)std::strtold(xml_lookat->Attribute("z"), nullptr),
+        (Real)std::strtold(xml_lookat->Attribute("x"), nullptr),
+        (Real)std::strtold(xml_lookat->Attribute("y"), nullptr),
+        (Real)std::strtold(xml_lookat->Attribute("z"), nullptr),
     };
 
-    Eigen::Vector3d up = Eigen::Vector3d
+    Vector3r up = Vector3r
     {
-        (double)std::strtold(xml_up->Attribute("x"), nullptr),
-        (double)std::strtold(xml_up->Attribute("y"), nullptr),
-        (double)std::strtold(xml_up->Attribute("z"), nullptr),
+        (Real)std::strtold(xml_up->Attribute("x"), nullptr),
+        (Real)std::strtold(xml_up->Attribute("y"), nullptr),
+        (Real)std::strtold(xml_up->Attribute("z"), nullptr),
     }.normalized();
 
     const Eigen::Index height = std::strtoll(xml_height, nullptr, 10);
     const Eigen::Index width = std::strtoll(xml_width, nullptr, 10);
-    const double fovy = ToRadians((double)std::strtold(xml_fovy, nullptr));
+    const Real fovy = ToRadians((Real)std::strtold(xml_fovy, nullptr));
 
     if (strcmp(xml_camera->Attribute("type"), "perspective") == 0) LIKELY
     {
-        return {CAMERA_TYPE_PERSPECTIVE, height, width, 0.1, INF, fovy, eye, lookat, up, lights, Eigen::Vector3d{0.0, 0.0, 0.0}};
+        return {CAMERA_TYPE_PERSPECTIVE, height, width, (Real)0.1, INF, fovy, eye, lookat, up, lights, Vector3r{0.0, 0.0, 0.0}};
     }
     else if (strcmp(xml_camera->Attribute("type"), "orthographic") == 0)
     {
-        return {CAMERA_TYPE_ORTHOGRAPHIC, height, width, 0.1, INF, fovy, eye, lookat, up, lights, Eigen::Vector3d{0.0, 0.0, 0.0}};
+        return {CAMERA_TYPE_ORTHOGRAPHIC, height, width, (Real)0.1, INF, fovy, eye, lookat, up, lights, Vector3r{0.0, 0.0, 0.0}};
     }
     else UNLIKELY
     {
@@ -30,38 +30,38 @@ struct Camera
     CameraType type;
     Eigen::Index height;
     Eigen::Index width;
-    double near;
-    double far;
-    double fovy;
-    double aspect;
-    Eigen::Vector3d origin;
+    Real near;
+    Real far;
+    Real fovy;
+    Real aspect;
+    Vector3r origin;
     ONB onb;
-    std::unordered_map<std::string, Ref<Texture2D<Eigen::Vector3d>>> lights;
-    Eigen::Vector3d background;
+    std::unordered_map<std::string, Ref<Texture2D<Vector3r>>> lights;
+    Vector3r background;
 
 public:
     NODISCARD Camera(
         CameraType type, const Eigen::Index height, const Eigen::Index width,
-        const double near, const double far, const double fovy,
-        const Eigen::Vector3d& origin, const Eigen::Vector3d& lookat,
-        std::unordered_map<std::string, Ref<Texture2D<Eigen::Vector3d>>> lights,
-        Eigen::Vector3d  background
+        const Real near, const Real far, const Real fovy,
+        const Vector3r& origin, const Vector3r& lookat,
+        std::unordered_map<std::string, Ref<Texture2D<Vector3r>>> lights,
+        Vector3r  background
     ) NOEXCEPT :
         type(type), height(height), width(width),
-        near(near), far(far), fovy(fovy), aspect((double)width / (double)height),
+        near(near), far(far), fovy(fovy), aspect((Real)width / (Real)height),
         origin(origin), onb((lookat - origin).normalized()), lights(std::move(lights)), background(std::move(background))
     {}
 
     NODISCARD Camera(
         CameraType type, const Eigen::Index height, const Eigen::Index width,
-        const double near, const double far, const double fovy,
-        const Eigen::Vector3d& origin, const Eigen::Vector3d& lookat,
-        const Eigen::Vector3d& up,
-        std::unordered_map<std::string, Ref<Texture2D<Eigen::Vector3d>>> lights,
-        Eigen::Vector3d  background
+        const Real near, const Real far, const Real fovy,
+        const Vector3r& origin, const Vector3r& lookat,
+        const Vector3r& up,
+        std::unordered_map<std::string, Ref<Texture2D<Vector3r>>> lights,
+        Vector3r  background
     ) NOEXCEPT :
         type(type), height(height), width(width),
-        near(near), far(far), fovy(fovy), aspect((double)width / (double)height),
+        near(near), far(far), fovy(fovy), aspect((Real)width / (Real)height),
         origin(origin), onb((lookat - origin).normalized(), up), lights(std::move(lights)), background(std::move(background))
     {}
 
@@ -70,16 +70,16 @@ public:
     // NODISCARD Ray SampleRay(const Eigen::Index row, const Eigen::Index col) const NOEXCEPT
     NODISCARD Ray SampleRay(const Eigen::Index row, const Eigen::Index col, const Eigen::Index jitter_size, const Eigen::Index jitter_row, const Eigen::Index jitter_col) const NOEXCEPT
     {
-        const double near_height = near * std::tan(fovy / 2.0) * 2.0;
-        const double near_width = near_height * aspect;
-        const double pixel_size = near_height / (double)height;
-        const double sub_pixel_size = pixel_size / (double)jitter_size;
-        auto dist = RNG::UniformDist<double>(-sub_pixel_size / 2.0, sub_pixel_size / 2.0);
-        const Eigen::Vector3d local_coord =
+        const Real near_height = near * std::tan(fovy / (Real)2.0) * (Real)2.0;
+        const Real near_width = near_height * aspect;
+        const Real pixel_size = near_height / (Real)height;
+        const Real sub_pixel_size = pixel_size / (Real)jitter_size;
+        auto dist = RNG::UniformDist<Real>(-sub_pixel_size / (Real)2.0, sub_pixel_size / (Real)2.0);
+        const Vector3r local_coord =
         {
             near,
-            ((near_height - sub_pixel_size) / 2.0 - (double)row * pixel_size - (double)jitter_row * sub_pixel_size) + RNG::Rand(dist),
-            ((sub_pixel_size - near_width) / 2.0 + (double)col * pixel_size + (double)jitter_col * sub_pixel_size) + RNG::Rand(dist),
+            ((near_height - sub_pixel_size) / (Real)2.0 - (Real)row * pixel_size - (Real)jitter_row * sub_pixel_size) + RNG::Rand(dist),
+            ((sub_pixel_size - near_width) / (Real)2.0 + (Real)col * pixel_size + (Real)jitter_col * sub_pixel_size) + RNG::Rand(dist),
         };
         return { origin, onb.Transform(local_coord).normalized() };
     }
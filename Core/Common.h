@@ -184,74 +184,102 @@ NODISCARD CONSTEXPR FORCE_INLINE Ref<T> MakeRef(Args&&... args) NOEXCEPT
     return std::make_shared<T>(std::forward<Args>(args)...);
 }
 
-CONSTEXPR double EPS = 10 * std::numeric_limits<double>::epsilon();
-CONSTEXPR double INF = std::numeric_limits<double>::infinity();
-CONSTEXPR double PI = 3.1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679;
+// Scalar Of Everything Traced And Shaded. Build With REAL_FLOAT (Target PathTracerFloat) For Single Precision.
+// BVH Construction Stays In Double Either Way, See BVHBuilder.
+#ifdef REAL_FLOAT
+using Real = float;
+#else
+using Real = double;
+#endif
+
+using Vector2r = Eigen::Matrix<Real, 2, 1>;
+using Vector3r = Eigen::Matrix<Real, 3, 1>;
+using Vector4r = Eigen::Matrix<Real, 4, 1>;
+using Matrix3r = Eigen::Matrix<Real, 3, 3>;
+using Affine3r = Eigen::Transform<Real, 3, Eigen::Affine>;
 
-NODISCARD FORCE_INLINE double ToRadians(const double degree) NOEXCEPT
+CONSTEXPR Real EPS = (Real)10 * std::numeric_limits<Real>::epsilon();
+CONSTEXPR Real INF = std::numeric_limits<Real>::infinity();
+CONSTEXPR Real PI = (Real)3.1415926535897932384626433832795028841971693993751058209749445923078164062862089986280348253421170679;
+
+NODISCARD FORCE_INLINE Real ToRadians(const Real degree) NOEXCEPT
 {
-    return degree * PI / 180.0;
+    return degree * PI / (Real)180.0;
 }
 
-NODISCARD FORCE_INLINE double ToDegree(const double radians) NOEXCEPT
+NODISCARD FORCE_INLINE Real ToDegree(const Real radians) NOEXCEPT
 {
-    return radians * 180.0 / PI;
+    return radians * (Real)180.0 / PI;
 }
 
-NODISCARD FORCE_INLINE bool Feq(const double x, const double y) NOEXCEPT
+NODISCARD FORCE_INLINE bool Feq(const Real x, const Real y) NOEXCEPT
 {
     return std::abs(x - y) <= EPS;
 }
 
-NODISCARD FORCE_INLINE bool Fne(const double x, const double y) NOEXCEPT
+NODISCARD FORCE_INLINE bool Fne(const Real x, const Real y) NOEXCEPT
 {
     return std::abs(x - y) > EPS;
 }
 
-NODISCARD FORCE_INLINE bool Fgt(const double x, const double y) NOEXCEPT
+NODISCARD FORCE_INLINE bool Fgt(const Real x, const Real y) NOEXCEPT
 {
     return x > y + EPS;
 }
 
-NODISCARD FORCE_INLINE bool Fge(const double x, const double y) NOEXCEPT
+NODISCARD FORCE_INLINE bool Fge(const Real x, const Real y) NOEXCEPT
 {
     return x >= y - EPS;
 }
 
-NODISCARD FORCE_INLINE bool Flt(const double x, const double y) NOEXCEPT
+NODISCARD FORCE_INLINE bool Flt(const Real x, const Real y) NOEXCEPT
 {
     return x < y - EPS;
 }
 
-NODISCARD FORCE_INLINE bool Fle(const double x, const double y) NOEXCEPT
+NODISCARD FORCE_INLINE bool Fle(const Real x, const Real y) NOEXCEPT
 {
     return x <= y + EPS;
 }
 
-NODISCARD FORCE_INLINE bool FIsZero(const double x) NOEXCEPT
+NODISCARD FORCE_INLINE bool FIsZero(const Real x) NOEXCEPT
 {
-    return Feq(x, 0.0);
+    return Feq(x, (Real)0.0);
 }
 
-NODISCARD FORCE_INLINE bool FIsInfinity(const double x) NOEXCEPT
+NODISCARD FORCE_INLINE bool FIsInfinity(const Real x) NOEXCEPT
 {
     return x == INF;
 }
 
-NODISCARD FORCE_INLINE bool FIsPositive(const double x) NOEXCEPT
+NODISCARD FORCE_INLINE bool FIsPositive(const Real x) NOEXCEPT
 {
-    return Fgt(x, 0.0);
+    return Fgt(x, (Real)0.0);
 }
 
-NODISCARD FORCE_INLINE bool FIsNegative(const double x) NOEXCEPT
+NODISCARD FORCE_INLINE bool FIsNegative(const Real x) NOEXCEPT
 {
-    return Flt(x, 0.0);
+    return Flt(x, (Real)0.0);
 }
 
-NODISCARD FORCE_INLINE double SSqrt(const double x) NOEXCEPT
+NODISCARD FORCE_INLINE Real SSqrt(const Real x) NOEXCEPT
 {
     if (FIsPositive(x)) { return std::sqrt(x); }
     return 0;
 }
 
+// Nearest Float Not Greater Than x.
+NODISCARD FORCE_INLINE float FRoundDown(const double x) NOEXCEPT
+{
+    const float f = (float)x;
+    return (double)f > x ? std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+}
+
+// Nearest Float Not Less Than x.
+NODISCARD FORCE_INLINE float FRoundUp(const double x) NOEXCEPT
+{
+    const float f = (float)x;
+    return (double)f < x ? std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+}
+
 #endif //COMMON_H
@@ -18,7 +18,7 @@
 
 struct Debug
 {
-    static void Dump(FILE* fp, const Eigen::Vector3d& v) NOEXCEPT;
+    static void Dump(FILE* fp, const Vector3r& v) NOEXCEPT;
 
     template<class T> FORCE_INLINE static void Unuse(T&& arg) NOEXCEPT { (void)arg; }
     template<class T, class... Args> FORCE_INLINE static void Unuse(T&& arg, Args&&... args) NOEXCEPT { (void)arg; Unuse(std::forward<Args>(args)...); }
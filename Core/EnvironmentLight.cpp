@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file           : EnvironmentLight.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-6
+  ******************************************************************************
+  */
+
+
+
+#include <Core/EnvironmentLight.h>
+
+namespace
+{
+
+// Segment i With cdf[i] <= u < cdf[i + 1], offset Is The Position Of u Within It In [0, 1).
+NODISCARD size_t SampleCDF(const Real* cdf, const size_t size, const Real u, Real& offset) NOEXCEPT
+{
+    const size_t index = std::clamp<size_t>((size_t)(std::upper_bound(cdf, cdf + size + 1, u) - cdf), 1, size) - 1;
+    const Real width = cdf[index + 1] - cdf[index];
+    offset = width > (Real)0.0 ? std::min((u - cdf[index]) / width, (Real)1.0 - std::numeric_limits<Real>::epsilon()) : (Real)0.5;
+    return index;
+}
+
+}
+
+EnvironmentLight::EnvironmentLight(Image image, const Real scale) NOEXCEPT
+: image(std::move(image)), scale(scale), integral((Real)0.0)
+{
+    const Eigen::Index height = this->image.Height();
+    const Eigen::Index width = this->image.Width();
+    marginal_cdf.assign(height + 1, (Real)0.0);
+    conditional_cdf.assign(height * (width + 1), (Real)0.0);
+
+    // Brightness * sin(theta) Of Each Pixel. sin(theta) Undoes The Stretching Of Rows Near The Poles.
+    std::vector<double> row_sums(height, 0.0);
+    std::vector<double> weights(width + 1);
+    for (Eigen::Index row = 0; row < height; ++row)
+    {
+        const double sin_theta = std::sin(PI * ((double)row + 0.5) / (double)height);
+        weights[0] = 0.0;
+        for (Eigen::Index col = 0; col < width; ++col)
+        {
+            const Vector4r& pixel = this->image(row, col);
+            weights[col + 1] = weights[col] + std::max(0.0, (double)(pixel.x() + pixel.y() + pixel.z()) / 3.0) * sin_theta;
+        }
+        row_sums[row] = weights[width];
+
+        Real* cdf = conditional_cdf.data() + row * (width + 1);
+        for (Eigen::Index col = 0; col <= width; ++col)
+        {
+            // Rows Of Zero Weight Are Never Picked, Any Valid CDF Will Do.
+            cdf[col] = row_sums[row] > 0.0 ? (Real)(weights[col] / row_sums[row]) : (Real)col / (Real)width;
+        }
+        cdf[width] = (Real)1.0;
+    }
+
+    const double sum = std::accumulate(row_sums.begin(), row_sums.end(), 0.0);
+    if (!(sum > 0.0) || !std::isfinite(sum))
+    {
+        return;
+    }
+
+    double partial = 0.0;
+    for (Eigen::Index row = 0; row < height; ++row)
+    {
+        marginal_cdf[row] = (Real)(partial / sum);
+        partial += row_sums[row];
+    }
+    marginal_cdf[height] = (Real)1.0;
+    integral = (Real)(sum / ((double)height * (double)width));
+}
+
+NODISCARD Vector3r EnvironmentLight::Radiance(const Vector3r& omega) const NOEXCEPT
+{
+    const Real phi = std::atan2(omega.z(), omega.x());
+    const Real theta = std::acos(std::clamp(omega.y(), (Real)-1.0, (Real)1.0));
+    const Eigen::Index row = std::min((Eigen::Index)(theta / PI * (Real)image.Height()), image.Height() - 1);
+    const Eigen::Index col = std::min((Eigen::Index)((phi + PI) / ((Real)2.0 * PI) * (Real)image.Width()), image.Width() - 1);
+    return image(row, col).head<3>() * scale;
+}
+
+NODISCARD bool EnvironmentLight::Sample(const Vector2r& u, Vector3r& omega, Vector3r& radiance, Real& pdf) const NOEXCEPT
+{
+    const size_t height = (size_t)image.Height();
+    const size_t width = (size_t)image.Width();
+
+    Real row_offset, col_offset;
+    const size_t row = SampleCDF(marginal_cdf.data(), height, u.y(), row_offset);
+    const size_t col = SampleCDF(conditional_cdf.data() + row * (width + 1), width, u.x(), col_offset);
+
+    const Real theta = PI * ((Real)row + row_offset) / (Real)height;
+    const Real phi = (Real)2.0 * PI * ((Real)col + col_offset) / (Real)width - PI;
+    const Real sin_theta = std::sin(theta);
+    if (!(sin_theta > (Real)0.0))
+    {
+        return false;
+    }
+
+    omega = Vector3r{ sin_theta * std::cos(phi), std::cos(theta), sin_theta * std::sin(phi) };
+    radiance = image((Eigen::Index)row, (Eigen::Index)col).head<3>() * scale;
+
+    // Density Over [0, 1]^2 Is weight / integral, The Map To The Sphere Has Jacobian 2 * PI^2 * sin(theta).
+    const Real* cdf = conditional_cdf.data() + row * (width + 1);
+    const Real weight = (marginal_cdf[row + 1] - marginal_cdf[row]) * (cdf[col + 1] - cdf[col]) * (Real)(height * width);
+    pdf = weight / ((Real)2.0 * PI * PI * sin_theta);
+    return pdf > (Real)0.0;
+}
+
+NODISCARD Real EnvironmentLight::PDF(const Vector3r& omega) const NOEXCEPT
+{
+    const size_t height = (size_t)image.Height();
+    const size_t width = (size_t)image.Width();
+
+    const Real phi = std::atan2(omega.z(), omega.x());
+    const Real theta = std::acos(std::clamp(omega.y(), (Real)-1.0, (Real)1.0));
+    const Real sin_theta = std::sin(theta);
+    if (!(sin_theta > (Real)0.0))
+    {
+        return (Real)0.0;
+    }
+
+    const size_t row = std::min((size_t)(theta / PI * (Real)height), height - 1);
+    const size_t col = std::min((size_t)((phi + PI) / ((Real)2.0 * PI) * (Real)width), width - 1);
+    const Real* cdf = conditional_cdf.data() + row * (width + 1);
+    const Real weight = (marginal_cdf[row + 1] - marginal_cdf[row]) * (cdf[col + 1] - cdf[col]) * (Real)(height * width);
+    return weight / ((Real)2.0 * PI * PI * sin_theta);
+}
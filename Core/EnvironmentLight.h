@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file           : EnvironmentLight.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-6
+  ******************************************************************************
+  */
+
+
+
+#ifndef ENVIRONMENTLIGHT_H
+#define ENVIRONMENTLIGHT_H
+
+#include <Core/Common.h>
+#include <Core/Image.h>
+
+// Radiance Arriving From Infinitely Far Away, Looked Up In A Latitude Longitude HDR Image. Row 0 Is +y (Up), Column 0
+// Is -x And Columns Run Towards -z. Directions Are Importance Sampled In Proportion To Pixel Brightness * sin(theta)
+// Through A Piecewise Constant Marginal (Rows) And Conditional (Columns Per Row) CDF.
+// Ref: https://pbr-book.org/4ed/Light_Sources/Infinite_Area_Lights#ImageInfiniteLights
+struct EnvironmentLight
+{
+    Image image;
+    Real scale;
+    std::vector<Real> marginal_cdf;    // Height + 1 Entries.
+    std::vector<Real> conditional_cdf; // (Width + 1) Entries Per Row.
+    Real integral;                     // Of The Sampling Weight Over [0, 1]^2, 0 When There Is Nothing To Sample.
+
+    NODISCARD EnvironmentLight() NOEXCEPT : scale((Real)1.0), integral((Real)0.0) {}
+
+    // Radiance Is The Pixel Value Times scale.
+    NODISCARD EnvironmentLight(Image image, Real scale) NOEXCEPT;
+
+    // Any Format stbi_loadf Reads.
+    NODISCARD static EnvironmentLight From(const char* filename, const Real scale) NOEXCEPT
+    {
+        return { Image::From(filename), scale };
+    }
+
+    NODISCARD FORCE_INLINE bool IsEmpty() const NOEXCEPT { return !(integral > (Real)0.0); }
+
+    NODISCARD Vector3r Radiance(const Vector3r& omega) const NOEXCEPT;
+
+    // omega Towards The Environment, pdf In Solid Angle. false On The Measure Zero Poles.
+    NODISCARD bool Sample(const Vector2r& u, Vector3r& omega, Vector3r& radiance, Real& pdf) const NOEXCEPT;
+    NODISCARD Real PDF(const Vector3r& omega) const NOEXCEPT;
+};
+
+#endif //ENVIRONMENTLIGHT_H
@@ -16,19 +16,130 @@ NODISCARD bool HittableList::Hit(const Ray &ray, const Interval& interval, HitRe
 {
     if (bvh == nullptr)
     {
-        record.t = INF;
+        // Hit Writes Only On Success, So Shrinking The Interval Keeps The Closest Record.
+        Interval t_interval = interval;
+        bool hit = false;
         for (const auto& hittable : data)
         {
-            if (HitRecord t_record; hittable->Hit(ray, interval, t_record))
+            if (hittable->Hit(ray, t_interval, record))
             {
-                if (Flt(t_record.t, record.t))
-                {
-                    record = t_record;
-                }
+                t_interval.imax = record.t;
+                hit = true;
             }
         }
-        return !FIsInfinity(record.t);
+        return hit;
     }
 
     return bvh->Hit(ray, interval, record);
 }
+
+NODISCARD bool HittableList::Occluded(const Ray& ray, const Interval& interval) const NOEXCEPT
+{
+    if (bvh == nullptr)
+    {
+        return std::any_of(data.begin(), data.end(), [&ray, &interval](const Ref<Hittable>& hittable)
+        {
+            return hittable->Occluded(ray, interval);
+        });
+    }
+
+    return bvh->Occluded(ray, interval);
+}
+
+namespace
+{
+
+// Query Each Bounding Box Once. The Builder Only Sees Plain Values.
+std::vector<BVHBuilder::Primitive> CreatePrimitives(const std::vector<Ref<Hittable>>& hittables) NOEXCEPT
+{
+    std::vector<BVHBuilder::Primitive> primitives(hittables.size());
+    for (size_t i = 0; i < hittables.size(); ++i)
+    {
+        const AABB& t_bounding_box = hittables[i]->GetBoundingBox();
+        auto& primitive = primitives[i];
+        primitive.bmin = t_bounding_box.bmin.cast<double>();
+        primitive.bmax = t_bounding_box.bmax.cast<double>();
+        primitive.center = (primitive.bmin + primitive.bmax) / 2.0;
+        primitive.index = (Eigen::Index)i;
+    }
+    return primitives;
+}
+
+}
+
+void HittableList::InitializeBVH(const BVHConfig& config) NOEXCEPT
+{
+    bvh = data.empty() ? nullptr : MakeRef<BVH>(data, config);
+    bounding_box = bvh == nullptr ? AABB{} : bvh->GetBoundingBox();
+    bvh_data.resize(data.size());
+    std::transform(data.begin(), data.end(), bvh_data.begin(), [](const Ref<Hittable>& hittable) { return hittable.get(); });
+}
+
+void HittableList::RefitBVH() NOEXCEPT
+{
+    const bool changed = !std::equal(data.begin(), data.end(), bvh_data.begin(), bvh_data.end(),
+        [](const Ref<Hittable>& hittable, const Hittable* built) { return hittable.get() == built; }
+    );
+    if (bvh == nullptr || changed)
+    {
+        const BVHConfig config = bvh == nullptr ? BVHConfig{} : bvh->tree.config;
+        InitializeBVH(config);
+        return;
+    }
+    bvh->Refit();
+    bounding_box = bvh->GetBoundingBox();
+}
+
+NODISCARD BVH::BVH(const std::vector<Ref<Hittable>>& hittables, const BVHConfig& config) NOEXCEPT
+: Hittable(HITTABLE_KIND_BVH)
+{
+    Build(hittables, config);
+}
+
+void BVH::Build(const std::vector<Ref<Hittable>>& hittables, const BVHConfig& config) NOEXCEPT
+{
+    tree = LinearBVH{};
+    bounding_box = AABB{};
+
+    if (hittables.empty()) UNLIKELY
+    {
+        this->hittables.clear();
+        return;
+    }
+
+    std::vector<BVHBuilder::Primitive> primitives = CreatePrimitives(hittables);
+
+    std::vector<Eigen::Index> order;
+    tree = LinearBVH::Build(primitives, config, order);
+
+    std::vector<Ref<Hittable>> ordered(hittables.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        ordered[i] = hittables[order[i]];
+    }
+    this->hittables = std::move(ordered);
+
+    bounding_box = tree.Bounds();
+}
+
+void BVH::Refit() NOEXCEPT
+{
+    if (hittables.empty()) UNLIKELY
+    {
+        return;
+    }
+
+    // Hittables Are Already In Build Order, So Primitive i Is Primitive i Of The Build.
+    tree.Refit(CreatePrimitives(hittables));
+
+    if (tree.NeedsRebuild())
+    {
+        // NOTE: Build Resets hittables And tree, Pass It Copies.
+        const std::vector<Ref<Hittable>> t_hittables = hittables;
+        const BVHConfig config = tree.config;
+        Build(t_hittables, config);
+        return;
+    }
+
+    bounding_box = tree.Bounds();
+}
@@ -15,10 +15,27 @@
 
 #include <Core/Common.h>
 #include <Core/Bounds.h>
+#include <Core/LinearBVH.h>
 
-struct Material;
+struct PackedMaterial;
+struct Hittable;
+struct SurfaceInteraction;
 
+// Written For Every Closer Candidate, So It Only Holds What Intersection Already Knows.
+// Shading Data Is Rebuilt Once For The Closest Hit, See Interact.
 struct HitRecord
+{
+    Real t;
+    Eigen::Index primitive;             // Leaf Local Id, E.g. The Triangle Of A Mesh.
+    Vector2r uv;                 // Barycentrics For Triangles, Unused Otherwise.
+    const Hittable* hittable = nullptr; // Leaf That Was Hit.
+    const Hittable* instance = nullptr; // Instance The Leaf Was Hit Through, If Any.
+
+    // Call Once After Hit Returned true, With The Same Ray.
+    NODISCARD SurfaceInteraction Interact(const Ray& ray) const NOEXCEPT;
+};
+
+struct SurfaceInteraction
 {
     enum ScatterType
     {
@@ -26,12 +43,11 @@ struct HitRecord
         SCATTER_TYPE_REFRACT,
     };
 
-    double t;
     ScatterType scatter_type;
-    Ref<Material> material;
-    Eigen::Vector2d texcoord;
-    Eigen::Vector3d hit_point;
-    Eigen::Vector3d hit_normal;
+    const PackedMaterial* material; // Owned By The Hittable, Outlives The Interaction.
+    Vector2r texcoord;
+    Vector3r hit_point;
+    Vector3r hit_normal;
 };
 
 struct Hittable
@@ -46,21 +62,35 @@ protected:
         HITTABLE_KIND_PRIMITIVE_END,
 
         HITTABLE_KIND_MESH,
+        HITTABLE_KIND_INSTANCE,
 
         HITTABLE_KIND_LIST,
         HITTABLE_KIND_BVH,
     } kind;
 
 public:
+    AABB bounding_box; // Kept Up To Date By Each Hittable, Empty Until It Has Any Geometry.
+
     NODISCARD CONSTEXPR FORCE_INLINE HittableKind Kind() const NOEXCEPT { return kind; }
+    NODISCARD FORCE_INLINE const AABB& GetBoundingBox() const NOEXCEPT { return bounding_box; }
     NODISCARD explicit Hittable(const HittableKind kind) NOEXCEPT : kind(kind) {}
     virtual ~Hittable() NOEXCEPT = default;
 
     // Interface.
-    NODISCARD virtual const Ref<BoundingBox>& GetBoundingBox() const NOEXCEPT = 0;
     NODISCARD virtual bool Hit(const Ray& ray, const Interval& interval, HitRecord& record) const NOEXCEPT = 0;
+    // Any Hit Inside interval. Stops At The First Intersection And Writes Nothing.
+    NODISCARD virtual bool Occluded(const Ray& ray, const Interval& interval) const NOEXCEPT = 0;
+    // Shading Data Of A Hit Recorded By This Hittable. Only Leaves And Instances Appear In A HitRecord.
+    virtual void Interact(const Ray& ray UNUSED, const HitRecord& record UNUSED, SurfaceInteraction& interaction UNUSED) const NOEXCEPT { ASSERT(false); }
 };
 
+NODISCARD FORCE_INLINE SurfaceInteraction HitRecord::Interact(const Ray& ray) const NOEXCEPT
+{
+    SurfaceInteraction interaction;
+    (instance != nullptr ? instance : hittable)->Interact(ray, *this, interaction);
+    return interaction;
+}
+
 struct BVH;
 
 struct HittableList final : Hittable
@@ -69,113 +99,53 @@ struct HittableList final : Hittable
 
     std::vector<Ref<Hittable>> data;
     Ref<BVH> bvh;
+    std::vector<const Hittable*> bvh_data; // data When bvh Was Built. bvh Keeps Them Alive, So The Pointers Stay Unique.
 
     NODISCARD HittableList() NOEXCEPT : Hittable(HITTABLE_KIND_LIST) {}
 
     void PushBack(const Ref<Hittable>& hittable) NOEXCEPT { data.push_back(hittable); }
     void PopBack() NOEXCEPT { data.pop_back(); }
-    void InitializeBVH() NOEXCEPT { bvh = MakeRef<BVH>(*this); }
+    void InitializeBVH(const BVHConfig& config = {}) NOEXCEPT;
+    // Call After Child Bounds Change. Rebuilds If Children Were Added, Removed, Replaced Or Reordered Since The Last Build.
+    void RefitBVH() NOEXCEPT;
 
-    NODISCARD const Ref<BoundingBox>& GetBoundingBox() const NOEXCEPT OVERRIDE;
     NODISCARD bool Hit(const Ray& ray, const Interval& interval, HitRecord& record) const NOEXCEPT OVERRIDE;
+    NODISCARD bool Occluded(const Ray& ray, const Interval& interval) const NOEXCEPT OVERRIDE;
 };
 
 struct BVH final : Hittable
 {
     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_KIND_BVH;}
 
-    Ref<Hittable> left;
-    Ref<Hittable> right;
-    Ref<BoundingBox> bounding_box;
+    std::vector<Ref<Hittable>> hittables; // Reordered So That Each Leaf References A Contiguous Range.
+    LinearBVH tree;
 
     NODISCARD BVH() NOEXCEPT
-    : Hittable(HITTABLE_KIND_BVH), left(nullptr), right(nullptr)
+    : Hittable(HITTABLE_KIND_BVH)
     {}
 
-    NODISCARD explicit BVH(HittableList& hittable_list, Eigen::Index start, Eigen::Index end) NOEXCEPT
-    : Hittable(HITTABLE_KIND_BVH), left(nullptr), right(nullptr)
-    {
-        ASSERT(start < end);
+    NODISCARD BVH(const std::vector<Ref<Hittable>>& hittables, const BVHConfig& config) NOEXCEPT;
 
-        if (start + 1 == end)
-        {
-            left = right = hittable_list.data[start];
-        }
-        else if (start + 2 == end)
-        {
-            left = hittable_list.data[start];
-            right = hittable_list.data[start + 1];
-        }
-        else
-        {
-            Eigen::Index mid = (start + end) / 2;
-            left = MakeRef<BVH>(hittable_list, start, mid);
-            right = MakeRef<BVH>(hittable_list, mid, end);
-        }
-
-        bounding_box = MakeRef<AABB>(
-            *Cast<AABB>(left->GetBoundingBox().get()),
-            *Cast<AABB>(right->GetBoundingBox().get())
-        );
-    }
+    void Build(const std::vector<Ref<Hittable>>& hittables, const BVHConfig& config) NOEXCEPT;
+    // Call After Child Bounds Change (E.g. Instance::SetTransform). Falls Back To Build Once The Tree Degrades.
+    void Refit() NOEXCEPT;
 
-    NODISCARD explicit BVH(HittableList& hittable_list) NOEXCEPT
-    : Hittable(HITTABLE_KIND_BVH), left(nullptr), right(nullptr)
+    NODISCARD bool Hit(const Ray &ray, const Interval &interval, HitRecord& record) const NOEXCEPT OVERRIDE
     {
-        static Eigen::Index axis = 2;
-        axis = (axis + 1) % 3;
-        std::vector hittables(hittable_list.data);
-        std::ranges::sort(hittables, [](const Ref<Hittable>& lhs, const Ref<Hittable>& rhs) -> bool
+        return tree.Traverse(ray, interval, [this, &ray, &record](const Eigen::Index index, Interval& t_interval) -> bool
         {
-            if (axis == 0)
-            {
-                return lhs->GetBoundingBox()->Center().x() < rhs->GetBoundingBox()->Center().x();
-            }
-            else if (axis == 1)
-            {
-                return lhs->GetBoundingBox()->Center().y() < rhs->GetBoundingBox()->Center().y();
-            }
-            else // if (axis == 2)
-            {
-                return lhs->GetBoundingBox()->Center().z() < rhs->GetBoundingBox()->Center().z();
-            }
+            if (!hittables[index]->Hit(ray, t_interval, record)) { return false; }
+            t_interval.imax = record.t;
+            return true;
         });
-
-        if (hittable_list.data.empty()) UNLIKELY
-        {
-            return;
-        }
-        else if (hittable_list.data.size() == 1) UNLIKELY
-        {
-            left = right = hittable_list.data[0];
-        }
-        else if (hittable_list.data.size() == 2) UNLIKELY
-        {
-            left = hittable_list.data[0];
-            right = hittable_list.data[1];
-        }
-        else
-        {
-            left = MakeRef<BVH>(hittable_list, 0, hittable_list.data.size() / 2);
-            right = MakeRef<BVH>(hittable_list, hittable_list.data.size() / 2, hittable_list.data.size());
-        }
-
-        bounding_box = MakeRef<AABB>(
-            *Cast<AABB>(left->GetBoundingBox().get()),
-            *Cast<AABB>(right->GetBoundingBox().get())
-        );
     }
-
-    NODISCARD const Ref<BoundingBox>& GetBoundingBox() const NOEXCEPT OVERRIDE { return bounding_box; }
-    NODISCARD bool Hit(const Ray &ray, const Interval &interval, HitRecord& record) const NOEXCEPT OVERRIDE // NOLINT(*-no-recursion)
+    NODISCARD bool Occluded(const Ray& ray, const Interval& interval) const NOEXCEPT OVERRIDE
     {
-        if (!bounding_box->Hit(ray, interval)) { return false; }
-        const bool hit_left = left && left->Hit(ray, interval, record);
-        const bool hit_right = right && right->Hit(ray, hit_left ? Interval(interval.imin, record.t) : interval, record);
-        return hit_left || hit_right;
+        return tree.Traverse<true>(ray, interval, [this, &ray](const Eigen::Index index, const Interval& t_interval) -> bool
+        {
+            return hittables[index]->Occluded(ray, t_interval);
+        });
     }
 };
 
-NODISCARD FORCE_INLINE const Ref<BoundingBox>& HittableList::GetBoundingBox() const NOEXCEPT { return bvh->GetBoundingBox(); }
-
 #endif //HITTABLE_H
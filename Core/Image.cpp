@@ -39,7 +39,11 @@
 NODISCARD Image Image::From(const char* filename) NOEXCEPT
 {
     int width, height, nr_channel;
-    const float* data = stbi_loadf(filename, &width, &height, &nr_channel, STBI_rgb_alpha);
+    float* data = stbi_loadf(filename, &width, &height, &nr_channel, STBI_rgb_alpha);
+    if (data == nullptr) UNLIKELY
+    {
+        FATAL("Error Loading Image File.\n");
+    }
 
     Image image(height, width);
 
@@ -56,6 +60,7 @@ NODISCARD Image Image::From(const char* filename) NOEXCEPT
         }
     );
 
+    stbi_image_free(data);
     return image;
 }
 
@@ -68,7 +73,7 @@ NODISCARD bool Image::ToPNG(const Image& image, const char* filename) NOEXCEPT
         {
             for (Eigen::Index i = (Eigen::Index)thread_begin; i < (Eigen::Index)thread_end; ++i)
             {
-                Eigen::Vector4d gamma_correction = Eigen::round(Eigen::pow(image.Data()[i].array(), 1.0 / 2.2) * 255.0);
+                Vector4r gamma_correction = Eigen::round(Eigen::pow(image.Data()[i].array(), (Real)(1.0 / 2.2)) * (Real)255.0);
                 buffer[(i << 2) | 0] = (stbi_uc)std::clamp((int)gamma_correction.x(), 0, 255);
                 buffer[(i << 2) | 1] = (stbi_uc)std::clamp((int)gamma_correction.y(), 0, 255);
                 buffer[(i << 2) | 2] = (stbi_uc)std::clamp((int)gamma_correction.z(), 0, 255);
@@ -83,3 +88,16 @@ NODISCARD bool Image::ToPNG(const Image& image, const char* filename) NOEXCEPT
 
     return result;
 }
+
+NODISCARD double Image::RMSE(const Image& lhs, const Image& rhs) NOEXCEPT
+{
+    ASSERT(lhs.Height() == rhs.Height() && lhs.Width() == rhs.Width());
+
+    double sum = 0.0;
+    for (Eigen::Index i = 0; i < lhs.Height() * lhs.Width(); ++i)
+    {
+        sum += (lhs.Data()[i].head<3>() - rhs.Data()[i].head<3>()).cast<double>().squaredNorm();
+    }
+
+    return std::sqrt(sum / (double)(3 * lhs.Height() * lhs.Width()));
+}
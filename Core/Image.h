@@ -17,7 +17,7 @@
 
 struct Image
 {
-    Eigen::Matrix<Eigen::Vector4d, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> data;
+    Eigen::Matrix<Vector4r, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> data;
 
     NODISCARD Image() NOEXCEPT = default;
 
@@ -36,22 +36,22 @@ struct Image
         return data.cols();
     }
 
-    NODISCARD FORCE_INLINE const Eigen::Vector4d* Data() const NOEXCEPT
+    NODISCARD FORCE_INLINE const Vector4r* Data() const NOEXCEPT
     {
         return data.array().data();
     }
 
-    NODISCARD FORCE_INLINE Eigen::Vector4d* Data() NOEXCEPT
+    NODISCARD FORCE_INLINE Vector4r* Data() NOEXCEPT
     {
         return data.array().data();
     }
     
-    NODISCARD FORCE_INLINE const Eigen::Vector4d& operator()(const Eigen::Index row, const Eigen::Index col) const NOEXCEPT
+    NODISCARD FORCE_INLINE const Vector4r& operator()(const Eigen::Index row, const Eigen::Index col) const NOEXCEPT
     {
         return data(row, col);
     }
     
-    NODISCARD FORCE_INLINE Eigen::Vector4d& operator()(const Eigen::Index row, const Eigen::Index col) NOEXCEPT
+    NODISCARD FORCE_INLINE Vector4r& operator()(const Eigen::Index row, const Eigen::Index col) NOEXCEPT
     {
         return data(row, col);
     }
@@ -59,6 +59,9 @@ struct Image
     NODISCARD static Image From(const char* filename) NOEXCEPT;
 
     NODISCARD static bool ToPNG(const Image& image, const char* filename) NOEXCEPT;
+
+    // Root Mean Square Difference Over The RGB Channels. Images Must Have The Same Size.
+    NODISCARD static double RMSE(const Image& lhs, const Image& rhs) NOEXCEPT;
 };
 
 #endif //IMAGE_H
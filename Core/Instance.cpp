@@ -0,0 +1,93 @@
+/**
+  ******************************************************************************
+  * @file           : Instance.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-25
+  ******************************************************************************
+  */
+
+
+
+#include <Core/Instance.h>
+
+NODISCARD Instance::Instance(Ref<Hittable> object, const Affine3r& transform) NOEXCEPT
+: Hittable(HITTABLE_KIND_INSTANCE), object(std::move(object))
+{
+    ASSERT(this->object != nullptr);
+    ASSERT(!Instance::ClassOf(this->object.get()));
+    SetTransform(transform);
+}
+
+void Instance::SetTransform(const Affine3r& transform) NOEXCEPT
+{
+    this->transform = transform;
+    inv_transform = transform.inverse();
+    normal_matrix = inv_transform.linear().transpose();
+
+    // World Bounds Of The Eight Transformed Corners.
+    const Vector3r& lo = object->GetBoundingBox().bmin;
+    const Vector3r& hi = object->GetBoundingBox().bmax;
+    Vector3r bmin = Vector3r::Constant(INF);
+    Vector3r bmax = Vector3r::Constant(-INF);
+    for (int i = 0; i < 8; ++i)
+    {
+        const Vector3r corner{ (i & 1) ? hi.x() : lo.x(), (i & 2) ? hi.y() : lo.y(), (i & 4) ? hi.z() : lo.z() };
+        const Vector3r p = transform * corner;
+        bmin = bmin.cwiseMin(p);
+        bmax = bmax.cwiseMax(p);
+    }
+    bounding_box = AABB(bmin, bmax);
+}
+
+NODISCARD bool Instance::Hit(const Ray& ray, const Interval& interval, HitRecord& record) const NOEXCEPT
+{
+    // NOTE: Primitives Such As Sphere Expect A Unit Direction, So The Object Space Ray Is Normalized And t Is Rescaled.
+    Vector3r direction = inv_transform.linear() * ray.direction;
+    const Real scale = direction.norm();
+    if (FIsZero(scale)) UNLIKELY
+    {
+        return false;
+    }
+    direction /= scale;
+
+    const Ray object_ray(inv_transform * ray.origin, direction);
+    const Interval object_interval(interval.imin * scale, interval.imax * scale);
+
+    if (!object->Hit(object_ray, object_interval, record)) { return false; }
+
+    record.t /= scale;
+    record.instance = this;
+
+    return true;
+}
+
+NODISCARD bool Instance::Occluded(const Ray& ray, const Interval& interval) const NOEXCEPT
+{
+    Vector3r direction = inv_transform.linear() * ray.direction;
+    const Real scale = direction.norm();
+    if (FIsZero(scale)) UNLIKELY
+    {
+        return false;
+    }
+    direction /= scale;
+
+    return object->Occluded(Ray(inv_transform * ray.origin, direction), Interval(interval.imin * scale, interval.imax * scale));
+}
+
+void Instance::Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT
+{
+    // Rebuild The Object Space Ray And t Of Hit, The Leaf Interacts In Object Space.
+    Vector3r direction = inv_transform.linear() * ray.direction;
+    const Real scale = direction.norm();
+    direction /= scale;
+
+    HitRecord object_record = record;
+    object_record.t *= scale;
+    object_record.instance = nullptr;
+    record.hittable->Interact(Ray(inv_transform * ray.origin, direction), object_record, interaction);
+
+    interaction.hit_point = transform * interaction.hit_point;
+    interaction.hit_normal = (normal_matrix * interaction.hit_normal).normalized();
+}
@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file           : Instance.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-25
+  ******************************************************************************
+  */
+
+
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <Core/Common.h>
+#include <Core/Hittable.h>
+
+// A Shared Object (Usually A Mesh With Its Own BVH) Placed By An Affine Transform.
+// Push Instances Into A HittableList And Call InitializeBVH To Get The Top Level BVH.
+// One Level Only, HitRecord Remembers A Single Instance.
+struct Instance final : Hittable
+{
+    NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_KIND_INSTANCE;}
+
+    Ref<Hittable> object;
+    Affine3r transform;     // Object To World.
+    Affine3r inv_transform; // World To Object.
+    Matrix3r normal_matrix; // Inverse Transpose Of The Linear Part.
+
+    NODISCARD Instance(Ref<Hittable> object, const Affine3r& transform) NOEXCEPT;
+
+    // Also Call After The Object Itself Was Refitted, So That The World Bounds Follow.
+    void SetTransform(const Affine3r& transform) NOEXCEPT;
+
+    NODISCARD bool Hit(const Ray& ray, const Interval& interval, HitRecord& record) const NOEXCEPT OVERRIDE;
+    NODISCARD bool Occluded(const Ray& ray, const Interval& interval) const NOEXCEPT OVERRIDE;
+    void Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT OVERRIDE;
+};
+
+#endif //INSTANCE_H
@@ -17,13 +17,13 @@
 
 struct Interval // (imin, imax)
 {
-    double imin, imax;
+    Real imin, imax;
 
     NODISCARD Interval() NOEXCEPT
     : imin(0), imax(0)
     {}
 
-    NODISCARD Interval(const double a, const double b) NOEXCEPT
+    NODISCARD Interval(const Real a, const Real b) NOEXCEPT
     : imin(std::min(a, b)), imax(std::max(a, b))
     {}
 
@@ -37,12 +37,12 @@ struct Interval // (imin, imax)
         return imin == -INF && imax == INF;
     }
 
-    NODISCARD double Center() const NOEXCEPT
+    NODISCARD Real Center() const NOEXCEPT
     {
-        return (imin + imax) / 2.0;
+        return (imin + imax) / (Real)2.0;
     }
 
-    NODISCARD FORCE_INLINE bool Contain(const double x) const NOEXCEPT
+    NODISCARD FORCE_INLINE bool Contain(const Real x) const NOEXCEPT
     {
         return Flt(imin, x) && Flt(x, imax);
     }
@@ -59,7 +59,7 @@ struct Interval // (imin, imax)
         return Fle(imin, oth.imax) && Fle(oth.imin, imax);
     }
 
-    NODISCARD FORCE_INLINE double Clamp(const double x) const NOEXCEPT
+    NODISCARD FORCE_INLINE Real Clamp(const Real x) const NOEXCEPT
     {
         ASSERT(!IsEmpty());
         if (Flt(x, imin)) UNLIKELY { return imin; }
@@ -67,14 +67,18 @@ struct Interval // (imin, imax)
         return x;
     }
 
-    NODISCARD FORCE_INLINE Interval Expand(const double padding) const NOEXCEPT
+    NODISCARD FORCE_INLINE Interval Expand(const Real padding) const NOEXCEPT
     {
         return { imin - padding, imax + padding };
     }
 
     NODISCARD FORCE_INLINE static Interval Intersection(const Interval& lhs, const Interval& rhs) NOEXCEPT
     {
-        return { std::max(lhs.imin, rhs.imin), std::min(lhs.imax, rhs.imax) };
+        // NOTE: Do Not Use The Constructor, It Swaps The Bounds And Hides Empty Intersections.
+        Interval result;
+        result.imin = std::max(lhs.imin, rhs.imin);
+        result.imax = std::min(lhs.imax, rhs.imax);
+        return result;
     }
 
     NODISCARD FORCE_INLINE static Interval Union(const Interval& lhs, const Interval& rhs) NOEXCEPT
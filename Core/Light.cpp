@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file           : Light.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-2
+  ******************************************************************************
+  */
+
+
+
+#include <Core/Light.h>
+#include <Core/Mesh.h>
+#include <Core/Primitive.h>
+
+namespace
+{
+
+// Index Of The New Emitter, -1 If The Emission Is Textured, Zero Or The Shape Has No Area.
+int32_t AppendEmitter(LightList& lights, const LightList::Emitter::EmitterShape shape, const Vector3r& v0, const Vector3r& e1, const Vector3r& e2, const PackedTexture& emission) NOEXCEPT
+{
+    // Textured Emission Is Still Gathered By BSDF Sampling Alone.
+    if (emission.texture != nullptr || !(emission.color.maxCoeff() > (Real)0.0))
+    {
+        return -1;
+    }
+
+    const Vector3r cross = e1.cross(e2);
+    const Real area = (shape == LightList::Emitter::EMITTER_SHAPE_TRIANGLE ? (Real)0.5 : (Real)1.0) * cross.norm();
+    if (!(area > (Real)0.0))
+    {
+        return -1;
+    }
+
+    if (lights.emitters.size() >= (size_t)std::numeric_limits<int32_t>::max())
+    {
+        FATAL("Too Many Emitters\n");
+    }
+    lights.emitters.push_back(LightList::Emitter{ shape, v0, e1, e2, cross.normalized(), emission.color, area });
+    return (int32_t)lights.emitters.size() - 1;
+}
+
+void AppendMesh(LightList& lights, const Mesh& mesh) NOEXCEPT
+{
+    std::vector<int32_t>& ids = lights.emitter_ids[&mesh];
+    ids.assign(mesh.triangles.size(), -1);
+
+    for (size_t i = 0; i < mesh.triangles.size(); ++i)
+    {
+        const Mesh::Triangle& triangle = mesh.triangles[i];
+        const Vector3r& v0 = mesh.vertices[triangle.point[0].vertex];
+        ids[i] = AppendEmitter(lights, LightList::Emitter::EMITTER_SHAPE_TRIANGLE,
+            v0, mesh.vertices[triangle.point[1].vertex] - v0, mesh.vertices[triangle.point[2].vertex] - v0,
+            mesh.packed_materials[mesh.material_ids.empty() ? 0 : mesh.material_ids[i]].emission
+        );
+    }
+}
+
+}
+
+void LightList::Append(const Hittable& hittable) NOEXCEPT
+{
+    if (const Mesh* mesh = DynCast<Mesh>(&hittable))
+    {
+        AppendMesh(*this, *mesh);
+    }
+    else if (const Triangle* triangle = DynCast<Triangle>(&hittable))
+    {
+        emitter_ids[triangle] = { AppendEmitter(*this, Emitter::EMITTER_SHAPE_TRIANGLE, triangle->origin, triangle->u, triangle->v, triangle->packed_material.emission) };
+    }
+    else if (const Quadrangle* quadrangle = DynCast<Quadrangle>(&hittable))
+    {
+        emitter_ids[quadrangle] = { AppendEmitter(*this, Emitter::EMITTER_SHAPE_PARALLELOGRAM, quadrangle->origin, quadrangle->u, quadrangle->v, quadrangle->packed_material.emission) };
+    }
+    else if (const HittableList* list = DynCast<HittableList>(&hittable))
+    {
+        for (const Ref<Hittable>& child : list->data)
+        {
+            Append(*child);
+        }
+    }
+}
+
+void LightList::Build() NOEXCEPT
+{
+    std::vector<LightBounds> bounds(emitters.size());
+    for (size_t i = 0; i < emitters.size(); ++i)
+    {
+        const Emitter& emitter = emitters[i];
+        AABB box(emitter.v0, emitter.v0 + emitter.e1);
+        box = AABB(box, AABB(emitter.v0 + emitter.e2, emitter.shape == Emitter::EMITTER_SHAPE_TRIANGLE ? emitter.v0 : Vector3r(emitter.v0 + emitter.e1 + emitter.e2)));
+        // Diffuse, So The Single Normal Emits Over Its Whole Hemisphere.
+        bounds[i] = LightBounds{ box, emitter.normal, (Real)1.0, (Real)0.0, emitter.area * emitter.radiance.sum(), emitter.TwoSided() };
+    }
+    tree.Build(bounds);
+}
+
+NODISCARD int32_t LightList::Find(const HitRecord& record) const NOEXCEPT
+{
+    if (record.instance != nullptr)
+    {
+        return -1;
+    }
+    const auto it = emitter_ids.find(record.hittable);
+    return it == emitter_ids.end() ? -1 : it->second[record.primitive];
+}
+
+// Uniform On The Picked Shape. Ref: https://pharr.org/matt/blog/2019/02/27/triangle-sampling-1
+NODISCARD bool LightList::Sample(const Vector3r& point, const Vector3r& normal, const Real u_select, const Vector2r& u, LightSample& sample) const NOEXCEPT
+{
+    const Real environment_prob = EnvironmentProb();
+    if (u_select < environment_prob)
+    {
+        if (!environment.Sample(u, sample.omega, sample.radiance, sample.pdf))
+        {
+            return false;
+        }
+        sample.distance = INF;
+        sample.pdf *= environment_prob;
+        return true;
+    }
+
+    uint32_t index;
+    Real pmf;
+    // u_select Rescaled Past The environment Share Is Again Uniform.
+    if (!tree.Sample(point, normal, (u_select - environment_prob) / ((Real)1.0 - environment_prob), index, pmf))
+    {
+        return false;
+    }
+
+    const Emitter& emitter = emitters[index];
+    Vector3r light_point;
+    if (emitter.shape == Emitter::EMITTER_SHAPE_TRIANGLE)
+    {
+        const Real su = SSqrt(u.x());
+        light_point = emitter.v0 + su * ((Real)1.0 - u.y()) * emitter.e1 + su * u.y() * emitter.e2;
+    }
+    else
+    {
+        light_point = emitter.v0 + u.x() * emitter.e1 + u.y() * emitter.e2;
+    }
+
+    const Vector3r to_light = light_point - point;
+    const Real distance2 = to_light.squaredNorm();
+    sample.distance = std::sqrt(distance2);
+    sample.omega = to_light / sample.distance;
+    // sample.omega Points Into The Emitter, So Its Lit Side Sees A Negative Cosine.
+    const Real cos_light = -emitter.normal.dot(sample.omega);
+    if (!(emitter.TwoSided() ? cos_light != (Real)0.0 : cos_light > (Real)0.0) || !(sample.distance > (Real)0.0))
+    {
+        return false;
+    }
+    sample.radiance = emitter.radiance;
+    sample.pdf = ((Real)1.0 - environment_prob) * pmf / emitter.area * distance2 / std::abs(cos_light);
+    return true;
+}
+
+NODISCARD Real LightList::PDF(const Vector3r& point, const Vector3r& normal, const int32_t emitter, const Vector3r& omega, const Real distance) const NOEXCEPT
+{
+    const Emitter& t_emitter = emitters[emitter];
+    const Real cos_light = -t_emitter.normal.dot(omega);
+    if (!(t_emitter.TwoSided() ? cos_light != (Real)0.0 : cos_light > (Real)0.0))
+    {
+        return (Real)0.0;
+    }
+    return ((Real)1.0 - EnvironmentProb()) * tree.PMF(point, normal, (uint32_t)emitter) / t_emitter.area * distance * distance / std::abs(cos_light);
+}
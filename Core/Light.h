@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file           : Light.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-2
+  ******************************************************************************
+  */
+
+
+
+#ifndef LIGHT_H
+#define LIGHT_H
+
+#include <Core/Common.h>
+#include <Core/LightTree.h>
+#include <Core/EnvironmentLight.h>
+
+struct Hittable;
+struct HitRecord;
+
+// Emissive Triangles And Quadrangles Of The Scene For Next Event Estimation. A LightTree Picks One In Proportion To
+// Its Estimated Contribution At The Shading Point. An Optional environment Shares Light Samples Evenly With The Tree.
+struct LightList
+{
+    struct Emitter // One Emissive Triangle Or Parallelogram, In World Space.
+    {
+        enum EmitterShape
+        {
+            EMITTER_SHAPE_TRIANGLE,      // v0, v0 + e1, v0 + e2.
+            EMITTER_SHAPE_PARALLELOGRAM, // v0 + s * e1 + t * e2, s And t In [0, 1].
+        };
+
+        EmitterShape shape;
+        Vector3r v0;
+        Vector3r e1;
+        Vector3r e2;
+        Vector3r normal; // Unit Geometric Normal, e1 x e2.
+        Vector3r radiance;
+        Real area;
+
+        // Matches What Rays Can Hit: Triangles Are Two Sided, Quadrangles Only Face normal.
+        NODISCARD FORCE_INLINE bool TwoSided() const NOEXCEPT { return shape == EMITTER_SHAPE_TRIANGLE; }
+    };
+
+    struct LightSample
+    {
+        Vector3r omega;  // Unit, From The Shading Point Towards The Light.
+        Real distance;   // INF For The environment.
+        Vector3r radiance;
+        Real pdf;        // Solid Angle Measure.
+    };
+
+    std::vector<Emitter> emitters;
+    LightTree tree; // Over emitters, Power Taken As Area * Radiance.
+    std::unordered_map<const Hittable*, std::vector<int32_t>> emitter_ids; // Per Primitive Of Each Hittable, -1 Where Not An Emitter.
+    EnvironmentLight environment; // Seen By Rays Leaving The Scene, Empty For None.
+
+    // Collects Mesh Triangles, Triangles And Quadrangles Whose Material Has A Constant, Non Zero Emission (Materials Named
+    // light* Get The XML <light> Radiance), Walking Into Lists. Spheres And Instances Are Left To BSDF Sampling.
+    // Call After Meshes Are Final (Their BVH Reorders triangles), Then Build.
+    void Append(const Hittable& hittable) NOEXCEPT;
+    void Build() NOEXCEPT;
+
+    NODISCARD FORCE_INLINE bool IsEmpty() const NOEXCEPT { return tree.IsEmpty() && environment.IsEmpty(); }
+
+    // Probability That Sample Goes To The environment Rather Than The Tree.
+    NODISCARD FORCE_INLINE Real EnvironmentProb() const NOEXCEPT
+    {
+        return environment.IsEmpty() ? (Real)0.0 : (tree.IsEmpty() ? (Real)1.0 : (Real)0.5);
+    }
+
+    // Emitter Index Of A Hit, -1 If The Hit Is Not On An Emitter Of This List.
+    NODISCARD int32_t Find(const HitRecord& record) const NOEXCEPT;
+
+    // Light Reaching point On A Surface With normal. false When The Picked Light Cannot Reach It.
+    NODISCARD bool Sample(const Vector3r& point, const Vector3r& normal, Real u_select, const Vector2r& u, LightSample& sample) const NOEXCEPT;
+    // Solid Angle Density Of Sample At point Reaching emitter Along omega After distance, For Weighting BSDF Sampled Hits.
+    NODISCARD Real PDF(const Vector3r& point, const Vector3r& normal, int32_t emitter, const Vector3r& omega, Real distance) const NOEXCEPT;
+    // Solid Angle Density Of Sample Returning The environment Along omega, For Weighting BSDF Sampled Misses.
+    NODISCARD FORCE_INLINE Real EnvironmentPDF(const Vector3r& omega) const NOEXCEPT
+    {
+        return EnvironmentProb() * environment.PDF(omega);
+    }
+};
+
+#endif //LIGHT_H
@@ -0,0 +1,336 @@
+/**
+  ******************************************************************************
+  * @file           : LightTree.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-4
+  ******************************************************************************
+  */
+
+
+
+#include <Core/LightTree.h>
+
+namespace
+{
+
+// Angle Between Two Directions, Clamped Against Rounding.
+NODISCARD FORCE_INLINE Real SafeACos(const Real x) NOEXCEPT
+{
+    return std::acos(std::clamp(x, (Real)-1.0, (Real)1.0));
+}
+
+// cos(max(0, theta_a - theta_b)).
+NODISCARD FORCE_INLINE Real CosSubClamped(const Real sin_theta_a, const Real cos_theta_a, const Real sin_theta_b, const Real cos_theta_b) NOEXCEPT
+{
+    if (cos_theta_a > cos_theta_b) { return (Real)1.0; }
+    return cos_theta_a * cos_theta_b + sin_theta_a * sin_theta_b;
+}
+
+// sin(max(0, theta_a - theta_b)).
+NODISCARD FORCE_INLINE Real SinSubClamped(const Real sin_theta_a, const Real cos_theta_a, const Real sin_theta_b, const Real cos_theta_b) NOEXCEPT
+{
+    if (cos_theta_a > cos_theta_b) { return (Real)0.0; }
+    return sin_theta_a * cos_theta_b - cos_theta_a * sin_theta_b;
+}
+
+// Surface Area Orientation Heuristic, Lower Is Better. extent_ratio Penalizes Splitting Along A Short Axis.
+NODISCARD Real Cost(const LightBounds& bounds, const Real extent_ratio) NOEXCEPT
+{
+    if (!(bounds.power > (Real)0.0))
+    {
+        return (Real)0.0;
+    }
+    const Real theta_o = SafeACos(bounds.cos_theta_o);
+    const Real theta_e = SafeACos(bounds.cos_theta_e);
+    const Real theta_w = std::min(theta_o + theta_e, PI);
+    const Real sin_theta_o = SSqrt((Real)1.0 - bounds.cos_theta_o * bounds.cos_theta_o);
+    const Real m_omega = (Real)2.0 * PI * ((Real)1.0 - bounds.cos_theta_o)
+        + PI / (Real)2.0 * ((Real)2.0 * theta_w * sin_theta_o - std::cos(theta_o - (Real)2.0 * theta_w) - (Real)2.0 * theta_o * sin_theta_o + bounds.cos_theta_o);
+    const Vector3r diagonal = bounds.box.bmax - bounds.box.bmin;
+    const Real area = (Real)2.0 * (diagonal.x() * diagonal.y() + diagonal.y() * diagonal.z() + diagonal.z() * diagonal.x());
+    return bounds.power * m_omega * extent_ratio * area;
+}
+
+// Index Of The First Emitter Of The Second Child. Binned SAOH, Median Split Where It Finds Nothing Or The Tree Gets Deep.
+size_t Split(const std::vector<LightBounds>& bounds, std::vector<uint32_t>& order, const size_t begin, const size_t end, const AABB& box, const int depth) NOEXCEPT
+{
+    CONSTEXPR int bucket_count = 12;
+    CONSTEXPR int max_saoh_depth = 32; // Median Splits Below Keep Every Trail Within 64 Bits.
+
+    Vector3r centroid_min = Vector3r::Constant(INF);
+    Vector3r centroid_max = Vector3r::Constant(-INF);
+    for (size_t i = begin; i < end; ++i)
+    {
+        const Vector3r centroid = bounds[order[i]].box.Center();
+        centroid_min = centroid_min.cwiseMin(centroid);
+        centroid_max = centroid_max.cwiseMax(centroid);
+    }
+
+    const Vector3r diagonal = box.bmax - box.bmin;
+    const auto bucket_of = [&centroid_min, &centroid_max](const Vector3r& centroid, const Eigen::Index axis) -> int
+    {
+        const Real t = (centroid[axis] - centroid_min[axis]) / (centroid_max[axis] - centroid_min[axis]);
+        return std::clamp((int)(t * (Real)bucket_count), 0, bucket_count - 1);
+    };
+
+    Real best_cost = INF;
+    Eigen::Index best_axis = -1;
+    int best_split = 0;
+    for (Eigen::Index axis = 0; axis < 3 && depth < max_saoh_depth; ++axis)
+    {
+        if (!(centroid_max[axis] > centroid_min[axis]))
+        {
+            continue;
+        }
+
+        std::array<LightBounds, bucket_count> buckets{};
+        for (size_t i = begin; i < end; ++i)
+        {
+            const LightBounds& t_bounds = bounds[order[i]];
+            LightBounds& bucket = buckets[bucket_of(t_bounds.box.Center(), axis)];
+            bucket = LightBounds::Union(bucket, t_bounds);
+        }
+
+        const Real extent_ratio = diagonal.maxCoeff() / diagonal[axis];
+        for (int split = 1; split < bucket_count; ++split)
+        {
+            LightBounds below{}, above{};
+            for (int b = 0; b < split; ++b) { below = LightBounds::Union(below, buckets[b]); }
+            for (int b = split; b < bucket_count; ++b) { above = LightBounds::Union(above, buckets[b]); }
+            if (const Real cost = Cost(below, extent_ratio) + Cost(above, extent_ratio); cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = split;
+            }
+        }
+    }
+
+    if (best_axis >= 0)
+    {
+        const auto middle = std::partition(order.begin() + (std::ptrdiff_t)begin, order.begin() + (std::ptrdiff_t)end,
+            [&bounds, &bucket_of, best_axis, best_split](const uint32_t emitter) -> bool
+            {
+                return bucket_of(bounds[emitter].box.Center(), best_axis) < best_split;
+            }
+        );
+        const size_t mid = (size_t)(middle - order.begin());
+        if (mid != begin && mid != end)
+        {
+            return mid;
+        }
+    }
+
+    Eigen::Index axis;
+    (centroid_max - centroid_min).maxCoeff(&axis);
+    const size_t mid = (begin + end) / 2;
+    std::nth_element(order.begin() + (std::ptrdiff_t)begin, order.begin() + (std::ptrdiff_t)mid, order.begin() + (std::ptrdiff_t)end,
+        [&bounds, axis](const uint32_t a, const uint32_t b) -> bool
+        {
+            return bounds[a].box.Center()[axis] < bounds[b].box.Center()[axis];
+        }
+    );
+    return mid;
+}
+
+uint32_t BuildNode(LightTree& tree, const std::vector<LightBounds>& bounds, std::vector<uint32_t>& order, const size_t begin, const size_t end, const uint64_t trail, const int depth) NOEXCEPT
+{
+    const uint32_t index = (uint32_t)tree.nodes.size();
+    if (end - begin == 1)
+    {
+        tree.nodes.push_back(LightTree::Node{ bounds[order[begin]], order[begin], true });
+        tree.trails[order[begin]] = trail;
+        return index;
+    }
+
+    AABB box;
+    for (size_t i = begin; i < end; ++i)
+    {
+        box = AABB(box, bounds[order[i]].box);
+    }
+
+    const size_t mid = Split(bounds, order, begin, end, box, depth);
+    ASSERT(depth < 64);
+
+    tree.nodes.push_back(LightTree::Node{ {}, 0, false });
+    BuildNode(tree, bounds, order, begin, mid, trail, depth + 1);
+    const uint32_t second = BuildNode(tree, bounds, order, mid, end, trail | ((uint64_t)1 << depth), depth + 1);
+    tree.nodes[index].index = second;
+    tree.nodes[index].bounds = LightBounds::Union(tree.nodes[index + 1].bounds, tree.nodes[second].bounds);
+    return index;
+}
+
+}
+
+// Ref: https://pbr-book.org/4ed/Light_Sources/Light_Sampling#TheLightBoundsImportanceFunction
+NODISCARD Real LightBounds::Importance(const Vector3r& point, const Vector3r& normal) const NOEXCEPT
+{
+    const Vector3r center = box.Center();
+    const Vector3r to_point = point - center;
+    const Real distance2 = to_point.squaredNorm();
+    const Real radius2 = (box.bmax - box.bmin).squaredNorm() / (Real)4.0;
+    const Vector3r omega = distance2 > (Real)0.0 ? Vector3r(to_point / std::sqrt(distance2)) : axis;
+
+    // Angle From The Cone To point, Less The Spread Of The Normals And Of The Box As Seen From point.
+    Real cos_theta_w = axis.dot(omega);
+    if (two_sided) { cos_theta_w = std::abs(cos_theta_w); }
+    const Real sin_theta_w = SSqrt((Real)1.0 - cos_theta_w * cos_theta_w);
+    const Real cos_theta_b = distance2 < radius2 ? (Real)-1.0 : SSqrt((Real)1.0 - radius2 / distance2);
+    const Real sin_theta_b = SSqrt((Real)1.0 - cos_theta_b * cos_theta_b);
+    const Real sin_theta_o = SSqrt((Real)1.0 - cos_theta_o * cos_theta_o);
+    const Real cos_theta_x = CosSubClamped(sin_theta_w, cos_theta_w, sin_theta_o, cos_theta_o);
+    const Real sin_theta_x = SinSubClamped(sin_theta_w, cos_theta_w, sin_theta_o, cos_theta_o);
+    const Real cos_theta_p = CosSubClamped(sin_theta_x, cos_theta_x, sin_theta_b, cos_theta_b);
+    if (cos_theta_p <= cos_theta_e)
+    {
+        return (Real)0.0;
+    }
+
+    // Clamped So Points Inside Or Near The Box Do Not Dominate.
+    Real importance = power * cos_theta_p / std::max(distance2, radius2);
+
+    const Real cos_theta_i = std::abs(omega.dot(normal));
+    const Real sin_theta_i = SSqrt((Real)1.0 - cos_theta_i * cos_theta_i);
+    importance *= CosSubClamped(sin_theta_i, cos_theta_i, sin_theta_b, cos_theta_b);
+    return std::max(importance, (Real)0.0);
+}
+
+NODISCARD LightBounds LightBounds::Union(const LightBounds& a, const LightBounds& b) NOEXCEPT
+{
+    if (!(a.power > (Real)0.0)) { return b; }
+    if (!(b.power > (Real)0.0)) { return a; }
+
+    LightBounds result{ AABB(a.box, b.box), a.axis, a.cos_theta_o, std::min(a.cos_theta_e, b.cos_theta_e), a.power + b.power, a.two_sided || b.two_sided };
+
+    // Smallest Cone Holding Both Normal Cones.
+    const Real theta_a = SafeACos(a.cos_theta_o);
+    const Real theta_b = SafeACos(b.cos_theta_o);
+    const Real theta_d = SafeACos(a.axis.dot(b.axis));
+    if (std::min(theta_d + theta_b, PI) <= theta_a)
+    {
+        return result;
+    }
+    if (std::min(theta_d + theta_a, PI) <= theta_b)
+    {
+        result.axis = b.axis;
+        result.cos_theta_o = b.cos_theta_o;
+        return result;
+    }
+
+    const Real theta_o = (theta_a + theta_d + theta_b) / (Real)2.0;
+    const Vector3r rotation_axis = a.axis.cross(b.axis);
+    if (theta_o >= PI || !(rotation_axis.squaredNorm() > (Real)0.0))
+    {
+        result.cos_theta_o = (Real)-1.0;
+        return result;
+    }
+    result.axis = (Eigen::AngleAxis<Real>(theta_o - theta_a, rotation_axis.normalized()) * a.axis).normalized();
+    result.cos_theta_o = std::cos(theta_o);
+    return result;
+}
+
+void LightTree::Build(const std::vector<LightBounds>& bounds) NOEXCEPT
+{
+    nodes.clear();
+    trails.assign(bounds.size(), 0);
+
+    std::vector<uint32_t> order;
+    for (size_t i = 0; i < bounds.size(); ++i)
+    {
+        if (bounds[i].power > (Real)0.0)
+        {
+            order.push_back((uint32_t)i);
+        }
+    }
+    if (order.empty())
+    {
+        return;
+    }
+
+    nodes.reserve(2 * order.size() - 1);
+    BuildNode(*this, bounds, order, 0, order.size(), 0, 0);
+}
+
+NODISCARD bool LightTree::Sample(const Vector3r& point, const Vector3r& normal, Real u, uint32_t& emitter, Real& pmf) const NOEXCEPT
+{
+    CONSTEXPR Real one_minus_epsilon = (Real)1.0 - std::numeric_limits<Real>::epsilon() / (Real)2.0;
+
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    pmf = (Real)1.0;
+    uint32_t index = 0;
+    while (!nodes[index].leaf)
+    {
+        const Real left = nodes[index + 1].bounds.Importance(point, normal);
+        const Real right = nodes[nodes[index].index].bounds.Importance(point, normal);
+        if (!(left + right > (Real)0.0))
+        {
+            return false;
+        }
+
+        // Reuses u For The Next Level.
+        const Real p_left = left / (left + right);
+        if (u < p_left)
+        {
+            u = std::min(u / p_left, one_minus_epsilon);
+            pmf *= p_left;
+            index = index + 1;
+        }
+        else
+        {
+            u = std::min((u - p_left) / ((Real)1.0 - p_left), one_minus_epsilon);
+            pmf *= (Real)1.0 - p_left;
+            index = nodes[index].index;
+        }
+    }
+
+    // A Lone Emitter Is Only Tested Here.
+    if (index == 0 && !(nodes[0].bounds.Importance(point, normal) > (Real)0.0))
+    {
+        return false;
+    }
+    emitter = nodes[index].index;
+    return true;
+}
+
+NODISCARD Real LightTree::PMF(const Vector3r& point, const Vector3r& normal, const uint32_t emitter) const NOEXCEPT
+{
+    if (IsEmpty())
+    {
+        return (Real)0.0;
+    }
+    if (nodes[0].leaf)
+    {
+        return nodes[0].bounds.Importance(point, normal) > (Real)0.0 ? (Real)1.0 : (Real)0.0;
+    }
+
+    Real pmf = (Real)1.0;
+    uint64_t trail = trails[emitter];
+    for (uint32_t index = 0; !nodes[index].leaf; trail >>= 1)
+    {
+        const Real left = nodes[index + 1].bounds.Importance(point, normal);
+        const Real right = nodes[nodes[index].index].bounds.Importance(point, normal);
+        if (!(left + right > (Real)0.0))
+        {
+            return (Real)0.0;
+        }
+
+        const Real p_left = left / (left + right);
+        if (trail & 1)
+        {
+            pmf *= (Real)1.0 - p_left;
+            index = nodes[index].index;
+        }
+        else
+        {
+            pmf *= p_left;
+            index = index + 1;
+        }
+    }
+    return pmf;
+}
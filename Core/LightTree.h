@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file           : LightTree.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-4
+  ******************************************************************************
+  */
+
+
+
+#ifndef LIGHTTREE_H
+#define LIGHTTREE_H
+
+#include <Core/Common.h>
+#include <Core/Bounds.h>
+
+// Spatial And Directional Bounds Of A Set Of Emitters.
+struct LightBounds
+{
+    AABB box;
+    Vector3r axis;    // Unit, Center Of The Normal Cone.
+    Real cos_theta_o; // Normals Lie Within theta_o Of axis.
+    Real cos_theta_e; // Emission Falls Off To Zero theta_e Past Each Normal, 0 (90 Degrees) For Diffuse Emitters.
+    Real power;
+    bool two_sided;
+
+    // Upper Bound Style Estimate Of The Light Reaching point On A Surface With normal, Up To A Constant Factor.
+    NODISCARD Real Importance(const Vector3r& point, const Vector3r& normal) const NOEXCEPT;
+
+    NODISCARD static LightBounds Union(const LightBounds& a, const LightBounds& b) NOEXCEPT;
+};
+
+// Binary BVH Over Emitters That Picks One By Walking Down, Choosing Each Child In Proportion To Its Importance
+// At The Shading Point. Cost Is Logarithmic In The Emitter Count, Nearby Facing Emitters Are Chosen Far More Often.
+// Ref: https://pbr-book.org/4ed/Light_Sources/Light_Sampling#BVHLightSampling
+struct LightTree
+{
+    struct Node
+    {
+        LightBounds bounds;
+        uint32_t index; // Emitter For Leaves, Second Child Otherwise. The First Child Directly Follows Its Parent.
+        bool leaf;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint64_t> trails; // Per Emitter, The Child Taken At Each Depth From The Root, Lowest Bit First.
+
+    // bounds Per Emitter, Which Are Numbered By Their Position.
+    void Build(const std::vector<LightBounds>& bounds) NOEXCEPT;
+
+    NODISCARD FORCE_INLINE bool IsEmpty() const NOEXCEPT { return nodes.empty(); }
+
+    // false When No Emitter Can Reach point. Otherwise pmf Is The Probability Of Picking emitter.
+    NODISCARD bool Sample(const Vector3r& point, const Vector3r& normal, Real u, uint32_t& emitter, Real& pmf) const NOEXCEPT;
+    // Probability That Sample At point Picks emitter.
+    NODISCARD Real PMF(const Vector3r& point, const Vector3r& normal, uint32_t emitter) const NOEXCEPT;
+};
+
+#endif //LIGHTTREE_H
@@ -0,0 +1,260 @@
+/**
+  ******************************************************************************
+  * @file           : LinearBVH.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-22
+  ******************************************************************************
+  */
+
+
+
+#include <Core/LinearBVH.h>
+#include <Core/Parallel.h>
+#include <Core/TreeletOptimizer.h>
+
+namespace
+{
+
+uint32_t Flatten(std::vector<LinearBVHNode>& nodes, const BVHBuildNode& build_node) NOEXCEPT // NOLINT(*-no-recursion)
+{
+    const uint32_t node_index = (uint32_t)nodes.size();
+    nodes.emplace_back();
+
+    LinearBVHNode node = {};
+    for (int a = 0; a < 3; ++a)
+    {
+        node.bmin[a] = FRoundDown(build_node.bmin[a]);
+        node.bmax[a] = FRoundUp(build_node.bmax[a]);
+    }
+
+    if (build_node.IsLeaf())
+    {
+        ASSERT(build_node.count <= std::numeric_limits<uint16_t>::max());
+        node.offset = (uint32_t)build_node.begin;
+        node.count = (uint16_t)build_node.count;
+    }
+    else
+    {
+        node.axis = (uint8_t)build_node.axis;
+        Flatten(nodes, *build_node.children[0]);
+        node.offset = Flatten(nodes, *build_node.children[1]);
+    }
+
+    nodes[node_index] = node;
+    return node_index;
+}
+
+}
+
+NODISCARD LinearBVH LinearBVH::Build(std::vector<BVHBuilder::Primitive>& primitives, const BVHConfig& config, std::vector<Eigen::Index>& order, const SBVHBuilder::Clip& clip) NOEXCEPT
+{
+    LinearBVH bvh;
+
+    BVHBuilder::Result result = config.spatial_splits ? SBVHBuilder::Build(primitives, config, clip) : BVHBuilder::Build(primitives, config);
+
+    if (result.root == nullptr) UNLIKELY
+    {
+        order = std::move(result.order);
+        return bvh;
+    }
+
+    if (config.treelet_optimization)
+    {
+        TreeletOptimizer::Optimize(result, config);
+    }
+
+    if (result.statistics.reference_count == result.statistics.primitive_count)
+    {
+        order = std::move(result.order);
+    }
+    else
+    {
+        // Duplicated References: Callers Still Get A Permutation (By First Use), Leaves Go Through references.
+        std::vector<Eigen::Index> slot(primitives.size(), -1);
+        order.clear();
+        order.reserve(primitives.size());
+        bvh.references.resize(result.order.size());
+        for (size_t i = 0; i < result.order.size(); ++i)
+        {
+            const Eigen::Index index = result.order[i];
+            if (slot[index] < 0)
+            {
+                slot[index] = (Eigen::Index)order.size();
+                order.push_back(index);
+            }
+            bvh.references[i] = (uint32_t)slot[index];
+        }
+        ASSERT(order.size() == primitives.size());
+    }
+
+    ASSERT(result.statistics.max_depth <= MAX_STACK_SIZE);
+    bvh.config = config;
+    switch (config.layout)
+    {
+    case BVHConfig::BVH_LAYOUT_WIDE4:
+        bvh.wide4 = WideBVH<4>::From(*result.root);
+        break;
+    case BVHConfig::BVH_LAYOUT_WIDE8:
+        bvh.wide8 = WideBVH<8>::From(*result.root);
+        break;
+    case BVHConfig::BVH_LAYOUT_QUANTIZED8:
+        bvh.quantized8 = QuantizedBVH<8, uint8_t>::From(WideBVH<8>::From(*result.root));
+        break;
+    case BVHConfig::BVH_LAYOUT_QUANTIZED16:
+        bvh.quantized16 = QuantizedBVH<8, uint16_t>::From(WideBVH<8>::From(*result.root));
+        break;
+    case BVHConfig::BVH_LAYOUT_BINARY:
+    default:
+    {
+        std::vector<LinearBVHNode> t_nodes;
+        t_nodes.reserve(result.statistics.node_count);
+        Flatten(t_nodes, *result.root);
+        bvh.nodes = std::move(t_nodes);
+        break;
+    }
+    }
+    bvh.bmin = result.root->bmin;
+    bvh.bmax = result.root->bmax;
+    bvh.statistics = result.statistics;
+    bvh.build_cost = bvh.cost = bvh.Cost();
+
+    return bvh;
+}
+
+void LinearBVH::Refit(const std::vector<BVHBuilder::Primitive>& primitives) NOEXCEPT
+{
+    if (IsEmpty()) UNLIKELY
+    {
+        return;
+    }
+
+    // Leaves Index Slots. Clipped References Grow Back To Full Primitive Bounds, Which Stays Conservative.
+    std::vector<BVHBuilder::Primitive> t_slots;
+    if (!references.empty())
+    {
+        t_slots.resize(references.size());
+        for (size_t i = 0; i < references.size(); ++i)
+        {
+            t_slots[i] = primitives[references[i]];
+        }
+    }
+    const std::vector<BVHBuilder::Primitive>& slots = references.empty() ? primitives : t_slots;
+
+    switch (config.layout)
+    {
+    case BVHConfig::BVH_LAYOUT_WIDE4:
+        wide4.Refit(slots);
+        break;
+    case BVHConfig::BVH_LAYOUT_WIDE8:
+        wide8.Refit(slots);
+        break;
+    case BVHConfig::BVH_LAYOUT_QUANTIZED8:
+        quantized8.Refit(slots);
+        break;
+    case BVHConfig::BVH_LAYOUT_QUANTIZED16:
+        quantized16.Refit(slots);
+        break;
+    case BVHConfig::BVH_LAYOUT_BINARY:
+    default:
+        // Leaves Touch The Primitives And Run In Parallel, The Interior Sweep Only Unions Float Boxes.
+        Parallel::For(0, nodes.size(), THREAD_POOL.ThreadNumber(),
+            [this, &slots](size_t thread_begin, size_t thread_end)
+            {
+                for (size_t i = thread_begin; i < thread_end; ++i)
+                {
+                    LinearBVHNode& node = nodes[i];
+                    if (!node.IsLeaf()) { continue; }
+                    Eigen::Vector3d t_bmin, t_bmax;
+                    BVHBuilder::RangeBounds(slots, node.offset, node.offset + node.count, t_bmin, t_bmax);
+                    for (int a = 0; a < 3; ++a)
+                    {
+                        node.bmin[a] = FRoundDown(t_bmin[a]);
+                        node.bmax[a] = FRoundUp(t_bmax[a]);
+                    }
+                }
+            }
+        );
+
+        // Children Always Follow Their Parent In Depth First Order.
+        for (size_t i = nodes.size(); i-- > 0;)
+        {
+            LinearBVHNode& node = nodes[i];
+            if (node.IsLeaf()) { continue; }
+            const LinearBVHNode& left = nodes[i + 1];
+            const LinearBVHNode& right = nodes[node.offset];
+            for (int a = 0; a < 3; ++a)
+            {
+                node.bmin[a] = std::min(left.bmin[a], right.bmin[a]);
+                node.bmax[a] = std::max(left.bmax[a], right.bmax[a]);
+            }
+        }
+        break;
+    }
+
+    BVHBuilder::RangeBounds(primitives, 0, (Eigen::Index)primitives.size(), bmin, bmax);
+    cost = Cost();
+}
+
+NODISCARD double LinearBVH::Cost() const NOEXCEPT
+{
+    switch (config.layout)
+    {
+    case BVHConfig::BVH_LAYOUT_WIDE4:
+        return wide4.Cost(config);
+    case BVHConfig::BVH_LAYOUT_WIDE8:
+        return wide8.Cost(config);
+    case BVHConfig::BVH_LAYOUT_QUANTIZED8:
+        return quantized8.Cost(config);
+    case BVHConfig::BVH_LAYOUT_QUANTIZED16:
+        return quantized16.Cost(config);
+    case BVHConfig::BVH_LAYOUT_BINARY:
+    default:
+        break;
+    }
+
+    if (nodes.empty()) UNLIKELY
+    {
+        return 0.0;
+    }
+
+    const auto area = [](const LinearBVHNode& node) -> double
+    {
+        return BVHBuilder::SurfaceArea(
+            Eigen::Vector3d{ node.bmin[0], node.bmin[1], node.bmin[2] },
+            Eigen::Vector3d{ node.bmax[0], node.bmax[1], node.bmax[2] });
+    };
+
+    const double root_area = area(nodes[0]);
+    if (root_area <= 0.0) UNLIKELY
+    {
+        return 0.0;
+    }
+
+    double sah_cost = 0.0;
+    for (const LinearBVHNode& node : nodes)
+    {
+        sah_cost += area(node) * (node.IsLeaf() ? config.intersection_cost * (double)node.count : config.traversal_cost);
+    }
+    return sah_cost / root_area;
+}
+
+NODISCARD size_t LinearBVH::MemoryUsage() const NOEXCEPT
+{
+    const size_t reference_bytes = references.size() * sizeof(uint32_t);
+    switch (config.layout)
+    {
+    case BVHConfig::BVH_LAYOUT_WIDE4:
+        return reference_bytes + wide4.nodes.size() * sizeof(WideBVHNode<4>);
+    case BVHConfig::BVH_LAYOUT_WIDE8:
+        return reference_bytes + wide8.nodes.size() * sizeof(WideBVHNode<8>);
+    case BVHConfig::BVH_LAYOUT_QUANTIZED8:
+        return reference_bytes + quantized8.nodes.size() * sizeof(QuantizedBVHNode<8, uint8_t>);
+    case BVHConfig::BVH_LAYOUT_QUANTIZED16:
+        return reference_bytes + quantized16.nodes.size() * sizeof(QuantizedBVHNode<8, uint16_t>);
+    case BVHConfig::BVH_LAYOUT_BINARY:
+    default:
+        return reference_bytes + nodes.size() * sizeof(LinearBVHNode);
+    }
+}
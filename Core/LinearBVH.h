@@ -0,0 +1,201 @@
+/**
+  ******************************************************************************
+  * @file           : LinearBVH.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-22
+  ******************************************************************************
+  */
+
+
+
+#ifndef LINEAR_BVH_H
+#define LINEAR_BVH_H
+
+#include <Core/Common.h>
+#include <Core/Ray.h>
+#include <Core/Interval.h>
+#include <Core/Bounds.h>
+#include <Core/BVHBuilder.h>
+#include <Core/SBVHBuilder.h>
+#include <Core/WideBVH.h>
+#include <Core/QuantizedBVH.h>
+#include <Core/Buffer.h>
+
+// Depth First Order. First Child Is The Next Node. Bounds Are Rounded Outwards To Float.
+struct alignas(32) LinearBVHNode
+{
+    float bmin[3];
+    float bmax[3];
+    uint32_t offset; // Leaf Node: First Primitive. Interior Node: Second Child.
+    uint16_t count;  // Leaf Node: Number Of Primitives. Zero For Interior Node.
+    uint8_t axis;    // Interior Node: Split Axis.
+    uint8_t pad;
+
+    NODISCARD FORCE_INLINE bool IsLeaf() const NOEXCEPT { return count > 0; }
+};
+
+static_assert(sizeof(LinearBVHNode) == 32);
+
+struct LinearBVH
+{
+    static CONSTEXPR Eigen::Index MAX_STACK_SIZE = 64;
+
+    BVHConfig config;
+    Buffer<uint32_t> references;           // Spatial Splits Only: Leaf Slot To Primitive, Primitives Appear In Several Leaves.
+    Buffer<LinearBVHNode> nodes;           // BVH_LAYOUT_BINARY.
+    WideBVH<4> wide4;                      // BVH_LAYOUT_WIDE4.
+    WideBVH<8> wide8;                      // BVH_LAYOUT_WIDE8.
+    QuantizedBVH<8, uint8_t> quantized8;   // BVH_LAYOUT_QUANTIZED8.
+    QuantizedBVH<8, uint16_t> quantized16; // BVH_LAYOUT_QUANTIZED16.
+    Eigen::Vector3d bmin = Eigen::Vector3d::Zero();
+    Eigen::Vector3d bmax = Eigen::Vector3d::Zero();
+    BVHStatistics statistics;
+    double build_cost = 0.0; // SAH Cost Of The Flattened Tree Right After Build.
+    double cost = 0.0;       // SAH Cost Of The Flattened Tree After The Last Refit.
+
+    // Primitives Are Reordered By The Build, order Is A Permutation And Primitive i Must Be Stored At order[i].
+    // clip Is Only Used With config.spatial_splits, See SBVHBuilder::Clip.
+    NODISCARD static LinearBVH Build(std::vector<BVHBuilder::Primitive>& primitives, const BVHConfig& config, std::vector<Eigen::Index>& order, const SBVHBuilder::Clip& clip = nullptr) NOEXCEPT;
+
+    // Recomputes Bounds Bottom Up Without Changing The Topology. primitives[i] Must Describe The i-th Primitive In Build Order.
+    void Refit(const std::vector<BVHBuilder::Primitive>& primitives) NOEXCEPT;
+
+    NODISCARD double Cost() const NOEXCEPT;
+
+    NODISCARD FORCE_INLINE bool NeedsRebuild() const NOEXCEPT
+    {
+        return cost > config.rebuild_threshold * build_cost;
+    }
+
+    NODISCARD FORCE_INLINE bool IsEmpty() const NOEXCEPT
+    {
+        return nodes.empty() && wide4.nodes.empty() && wide8.nodes.empty() && quantized8.nodes.empty() && quantized16.nodes.empty();
+    }
+
+    // Node And Reference Arrays Of The Active Layout.
+    NODISCARD size_t MemoryUsage() const NOEXCEPT;
+
+    NODISCARD AABB Bounds() const NOEXCEPT
+    {
+        ASSERT(!IsEmpty());
+        return { bmin.cast<Real>(), bmax.cast<Real>() };
+    }
+
+    NODISCARD FORCE_INLINE static bool Hit(const LinearBVHNode& node, const Ray& ray, const Interval& interval, Real& t_entry) NOEXCEPT
+    {
+        return AABB::Hit(node.bmin, node.bmax, ray, interval, t_entry);
+    }
+
+    // HitPrimitive: bool(Eigen::Index index, Interval& interval). Shrinks interval.imax On A Closer Hit.
+    // ANY_HIT: Stop At The First Primitive Hit, For Occlusion Queries.
+    template<bool ANY_HIT = false, typename HitPrimitive>
+    NODISCARD FORCE_INLINE bool Traverse(const Ray& ray, const Interval& interval, HitPrimitive&& hit_primitive) const NOEXCEPT
+    {
+        if (references.empty()) LIKELY
+        {
+            return TraverseLayout<ANY_HIT>(ray, interval, std::forward<HitPrimitive>(hit_primitive));
+        }
+        return TraverseLayout<ANY_HIT>(ray, interval, [this, &hit_primitive](const Eigen::Index index, Interval& t_interval) -> bool
+        {
+            return hit_primitive((Eigen::Index)references[index], t_interval);
+        });
+    }
+
+    template<bool ANY_HIT, typename HitPrimitive>
+    NODISCARD FORCE_INLINE bool TraverseLayout(const Ray& ray, const Interval& interval, HitPrimitive&& hit_primitive) const NOEXCEPT
+    {
+        switch (config.layout)
+        {
+        case BVHConfig::BVH_LAYOUT_WIDE4:
+            return wide4.Traverse<ANY_HIT>(ray, interval, std::forward<HitPrimitive>(hit_primitive));
+        case BVHConfig::BVH_LAYOUT_WIDE8:
+            return wide8.Traverse<ANY_HIT>(ray, interval, std::forward<HitPrimitive>(hit_primitive));
+        case BVHConfig::BVH_LAYOUT_QUANTIZED8:
+            return quantized8.Traverse<ANY_HIT>(ray, interval, std::forward<HitPrimitive>(hit_primitive));
+        case BVHConfig::BVH_LAYOUT_QUANTIZED16:
+            return quantized16.Traverse<ANY_HIT>(ray, interval, std::forward<HitPrimitive>(hit_primitive));
+        case BVHConfig::BVH_LAYOUT_BINARY:
+        default:
+            return TraverseBinary<ANY_HIT>(ray, interval, std::forward<HitPrimitive>(hit_primitive));
+        }
+    }
+
+    template<bool ANY_HIT, typename HitPrimitive>
+    NODISCARD bool TraverseBinary(const Ray& ray, const Interval& interval, HitPrimitive&& hit_primitive) const NOEXCEPT
+    {
+        if (nodes.empty()) UNLIKELY
+        {
+            return false;
+        }
+
+        Interval t_interval = interval;
+        Real t_entry;
+        if (!Hit(nodes[0], ray, t_interval, t_entry)) { return false; }
+
+        struct StackEntry
+        {
+            uint32_t node;
+            Real t_entry;
+        };
+
+        StackEntry stack[MAX_STACK_SIZE];
+        Eigen::Index top = 0;
+        uint32_t current = 0;
+        bool hit = false;
+
+        while (true)
+        {
+            const LinearBVHNode& node = nodes[current];
+
+            if (node.IsLeaf())
+            {
+                for (uint32_t i = node.offset; i < node.offset + node.count; ++i)
+                {
+                    if (!hit_primitive((Eigen::Index)i, t_interval)) { continue; }
+                    if CONSTEXPR (ANY_HIT) { return true; }
+                    hit = true;
+                }
+            }
+            else
+            {
+                // Second Child Holds The Larger Coordinates Along The Split Axis.
+                const uint32_t near = ray.sign[node.axis] ? node.offset : current + 1;
+                const uint32_t far = ray.sign[node.axis] ? current + 1 : node.offset;
+
+                Real t_near, t_far;
+                const bool hit_near = Hit(nodes[near], ray, t_interval, t_near);
+                const bool hit_far = Hit(nodes[far], ray, t_interval, t_far);
+
+                if (hit_near)
+                {
+                    if (hit_far)
+                    {
+                        ASSERT(top < MAX_STACK_SIZE);
+                        stack[top++] = StackEntry{ far, t_far };
+                    }
+                    current = near;
+                    continue;
+                }
+                if (hit_far)
+                {
+                    current = far;
+                    continue;
+                }
+            }
+
+            // Skip Deferred Children That Start Behind The Closest Hit So Far.
+            do
+            {
+                if (top == 0) { return hit; }
+                --top;
+            }
+            while (stack[top].t_entry > t_interval.imax);
+
+            current = stack[top].node;
+        }
+    }
+};
+
+#endif //LINEAR_BVH_H
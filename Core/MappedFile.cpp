@@ -0,0 +1,77 @@
+/**
+  ******************************************************************************
+  * @file           : MappedFile.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-29
+  ******************************************************************************
+  */
+
+
+
+#include <Core/MappedFile.h>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+MappedFile::~MappedFile() NOEXCEPT
+{
+    #ifdef _WIN32
+    if (data != nullptr) { UnmapViewOfFile(data); }
+    if (mapping != nullptr) { CloseHandle(mapping); }
+    if (file != nullptr) { CloseHandle(file); }
+    #else
+    if (data != nullptr) { munmap(data, size); }
+    #endif
+}
+
+NODISCARD Ref<MappedFile> MappedFile::Open(const char* filename) NOEXCEPT
+{
+    Ref<MappedFile> mapped = MakeRef<MappedFile>();
+
+    #ifdef _WIN32
+    const HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { return nullptr; }
+    mapped->file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { return nullptr; }
+    mapped->size = (size_t)size.QuadPart;
+
+    mapped->mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapped->mapping == nullptr) { return nullptr; }
+
+    mapped->data = MapViewOfFile(mapped->mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (mapped->data == nullptr) { return nullptr; }
+    #else
+    const int fd = open(filename, O_RDONLY);
+    if (fd < 0) { return nullptr; }
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    // The Mapping Keeps The File Alive, The Descriptor Is Not Needed Any More.
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) { return nullptr; }
+
+    mapped->data = data;
+    mapped->size = (size_t)st.st_size;
+    #endif
+
+    return mapped;
+}
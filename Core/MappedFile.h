@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file           : MappedFile.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-29
+  ******************************************************************************
+  */
+
+
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <Core/Common.h>
+
+// Private Copy On Write Mapping Of A Whole File. Pages Are Shared With Every Process Mapping The Same File Until Written.
+struct MappedFile
+{
+    void* data = nullptr;
+    size_t size = 0;
+
+    #ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+    #endif
+
+    NODISCARD MappedFile() NOEXCEPT = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() NOEXCEPT;
+
+    NODISCARD FORCE_INLINE const uint8_t* Bytes() const NOEXCEPT { return (const uint8_t*)data; }
+    NODISCARD FORCE_INLINE uint8_t* Bytes() NOEXCEPT { return (uint8_t*)data; }
+
+    // nullptr If The File Cannot Be Opened Or Is Empty.
+    NODISCARD static Ref<MappedFile> Open(const char* filename) NOEXCEPT;
+};
+
+#endif //MAPPED_FILE_H
@@ -12,25 +12,42 @@
 
 #include <Core/Material.h>
 
-NODISCARD Eigen::Vector3d LambertMaterial::BRDF(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal UNUSED, const Eigen::Vector3d& omega_i UNUSED, const Eigen::Vector3d& omega_o UNUSED) const NOEXCEPT
+NODISCARD PackedMaterial PackedMaterial::From(const Material* material) NOEXCEPT
 {
-    return albedo_tex->Sample(texcoord2d) / PI;
-}
+    if (const BlinnPhongMaterial* blinn_phong = DynCast<BlinnPhongMaterial>(material); blinn_phong != nullptr)
+    {
+        return PackedMaterial{
+            PACKED_MATERIAL_KIND_BLINNPHONG,
+            blinn_phong->ns,
+            PackedTexture::From(blinn_phong->diffuse_tex.get()),
+            PackedTexture::From(blinn_phong->specular_tex.get()),
+            PackedTexture::From(blinn_phong->emission_tex.get()),
+        };
+    }
 
-NODISCARD Eigen::Vector3d LambertMaterial::Emission(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal UNUSED, const Eigen::Vector3d& omega_o UNUSED) const NOEXCEPT
-{
-    return emission_tex->Sample(texcoord2d);
-}
-
-NODISCARD Eigen::Vector3d BlinnPhongMaterial::BRDF(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal, const Eigen::Vector3d& omega_i, const Eigen::Vector3d& omega_o) const NOEXCEPT
-{
-    const Eigen::Vector3d diffuse_term = diffuse_tex->Sample(texcoord2d) / PI;
-    const Eigen::Vector3d half = (omega_i + omega_o).normalized();
-    const Eigen::Vector3d specular_term = specular_tex->Sample(texcoord2d) * ((ns + 2.0) / (2.0 * PI)) * std::pow(std::max(normal.dot(half), 0.0), ns);
-    return diffuse_term + specular_term;
+    const LambertMaterial* lambert = Cast<LambertMaterial>(material);
+    return PackedMaterial{
+        PACKED_MATERIAL_KIND_LAMBERT,
+        (Real)0.0,
+        PackedTexture::From(lambert->albedo_tex.get()),
+        PackedTexture::From(nullptr),
+        PackedTexture::From(lambert->emission_tex.get()),
+    };
 }
 
-NODISCARD Eigen::Vector3d BlinnPhongMaterial::Emission(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal UNUSED, const Eigen::Vector3d& omega_o UNUSED) const NOEXCEPT
+NODISCARD Vector3r ShadingContext::BRDF(const Vector3r& normal, const Vector3r& omega_i, const Vector3r& omega_o) const NOEXCEPT
 {
-    return emission_tex->Sample(texcoord2d);
+    switch (kind)
+    {
+    case PackedMaterial::PACKED_MATERIAL_KIND_BLINNPHONG:
+    {
+        const Vector3r diffuse_term = diffuse / PI;
+        const Vector3r half = (omega_i + omega_o).normalized();
+        const Vector3r specular_term = specular * ((ns + (Real)2.0) / ((Real)2.0 * PI)) * std::pow(std::max(normal.dot(half), (Real)0.0), ns);
+        return diffuse_term + specular_term;
+    }
+    case PackedMaterial::PACKED_MATERIAL_KIND_LAMBERT:
+    default:
+        return diffuse / PI;
+    }
 }
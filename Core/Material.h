@@ -34,68 +34,96 @@ public:
 
     NODISCARD explicit Material(const MaterialKind kind) NOEXCEPT : kind(kind) {}
     virtual ~Material() NOEXCEPT = default;
-
-    NODISCARD virtual Eigen::Vector3d BRDF(
-        const Eigen::Vector2d& texcoord2d,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_i,
-        const Eigen::Vector3d& omega_o
-    ) const NOEXCEPT = 0;
-    NODISCARD virtual Eigen::Vector3d Emission(
-        const Eigen::Vector2d& texcoord2d,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_o
-    ) const NOEXCEPT = 0;
 };
 
 struct LambertMaterial final : Material
 {
     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Material* ptr) NOEXCEPT {return ptr->Kind() == MATERIAL_KIND_LAMBERT;}
 
-    Ref<Texture2D<Eigen::Vector3d>> albedo_tex;
-    Ref<Texture2D<Eigen::Vector3d>> emission_tex;
+    Ref<Texture2D<Vector3r>> albedo_tex;
+    Ref<Texture2D<Vector3r>> emission_tex;
 
     NODISCARD LambertMaterial() NOEXCEPT
     : Material(MATERIAL_KIND_LAMBERT), albedo_tex(nullptr), emission_tex(nullptr)
     {}
 
     NODISCARD explicit LambertMaterial(
-        const Ref<Texture2D<Eigen::Vector3d>>& albedo_tex,
-        const Ref<Texture2D<Eigen::Vector3d>>& emission_tex
+        const Ref<Texture2D<Vector3r>>& albedo_tex,
+        const Ref<Texture2D<Vector3r>>& emission_tex
     ) NOEXCEPT
     : Material(MATERIAL_KIND_LAMBERT), albedo_tex(albedo_tex), emission_tex(emission_tex)
     {}
-
-    NODISCARD Eigen::Vector3d BRDF(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal, const Eigen::Vector3d& omega_i, const Eigen::Vector3d& omega_o) const NOEXCEPT OVERRIDE;
-    NODISCARD Eigen::Vector3d Emission(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal, const Eigen::Vector3d& omega_o) const NOEXCEPT OVERRIDE;
 };
 
 struct BlinnPhongMaterial final : Material
 {
     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Material* ptr) NOEXCEPT {return ptr->Kind() == MATERIAL_KIND_BLINNPHONG;}
 
-    const double ns;
-    Ref<Texture2D<Eigen::Vector3d>> ambient_tex;
-    Ref<Texture2D<Eigen::Vector3d>> diffuse_tex;
-    Ref<Texture2D<Eigen::Vector3d>> specular_tex;
-    Ref<Texture2D<Eigen::Vector3d>> emission_tex;
+    const Real ns;
+    Ref<Texture2D<Vector3r>> ambient_tex;
+    Ref<Texture2D<Vector3r>> diffuse_tex;
+    Ref<Texture2D<Vector3r>> specular_tex;
+    Ref<Texture2D<Vector3r>> emission_tex;
 
     NODISCARD BlinnPhongMaterial() NOEXCEPT
     : Material(MATERIAL_KIND_BLINNPHONG), ns(2.0), ambient_tex(nullptr), diffuse_tex(nullptr), specular_tex(nullptr), emission_tex(nullptr)
     {}
 
     NODISCARD explicit BlinnPhongMaterial(
-        const double ns,
-        const Ref<Texture2D<Eigen::Vector3d>>& ambient_tex,
-        const Ref<Texture2D<Eigen::Vector3d>>& diffuse_tex,
-        const Ref<Texture2D<Eigen::Vector3d>>& specular_tex,
-        const Ref<Texture2D<Eigen::Vector3d>>& emission_tex
+        const Real ns,
+        const Ref<Texture2D<Vector3r>>& ambient_tex,
+        const Ref<Texture2D<Vector3r>>& diffuse_tex,
+        const Ref<Texture2D<Vector3r>>& specular_tex,
+        const Ref<Texture2D<Vector3r>>& emission_tex
     ) NOEXCEPT
     : Material(MATERIAL_KIND_BLINNPHONG), ns(ns), ambient_tex(ambient_tex), diffuse_tex(diffuse_tex), specular_tex(specular_tex), emission_tex(emission_tex)
     {}
+};
+
+struct ShadingContext;
+
+// Materials Describe, PackedMaterial Shades: A Tagged Copy Of The Closed Material Set With Pure Color Textures
+// Inlined, Dispatched By A Switch. Owners Keep Them Contiguous Next To The Materials, See Mesh::packed_materials.
+struct PackedMaterial
+{
+    enum PackedMaterialKind
+    {
+        PACKED_MATERIAL_KIND_LAMBERT,
+        PACKED_MATERIAL_KIND_BLINNPHONG,
+    };
 
-    NODISCARD Eigen::Vector3d BRDF(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal, const Eigen::Vector3d& omega_i, const Eigen::Vector3d& omega_o) const NOEXCEPT OVERRIDE;
-    NODISCARD Eigen::Vector3d Emission(const Eigen::Vector2d& texcoord2d, const Eigen::Vector3d& normal, const Eigen::Vector3d& omega_o) const NOEXCEPT OVERRIDE;
+    PackedMaterialKind kind;
+    Real ns;                // Blinn Phong Only.
+    PackedTexture diffuse;  // Lambert Albedo.
+    PackedTexture specular; // Blinn Phong Only.
+    PackedTexture emission;
+
+    NODISCARD static PackedMaterial From(const Material* material) NOEXCEPT;
+
+    // Samples Every Texture Once.
+    NODISCARD FORCE_INLINE ShadingContext Shade(const Vector2r& texcoord2d) const NOEXCEPT;
 };
 
+// The Texture Inputs Of A Material At One Hit. Sampler Weights, BRDF And Emission All Read These Instead Of
+// Sampling The Textures Again.
+struct ShadingContext
+{
+    PackedMaterial::PackedMaterialKind kind;
+    Real ns;
+    Vector3r diffuse;
+    Vector3r specular;
+    Vector3r emission;
+
+    NODISCARD Vector3r BRDF(
+        const Vector3r& normal,
+        const Vector3r& omega_i,
+        const Vector3r& omega_o
+    ) const NOEXCEPT;
+};
+
+NODISCARD FORCE_INLINE ShadingContext PackedMaterial::Shade(const Vector2r& texcoord2d) const NOEXCEPT
+{
+    return ShadingContext{ kind, ns, diffuse.Sample(texcoord2d), specular.Sample(texcoord2d), emission.Sample(texcoord2d) };
+}
+
 #endif //MATERIAL_H
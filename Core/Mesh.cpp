@@ -11,81 +11,352 @@
 
 
 #include <Core/Mesh.h>
+#include <Core/MeshCache.h>
 #include <Core/Parallel.h>
 #include <Core/Interval.h>
 #include <Core/Ray.h>
 #include <tiny_obj_loader.h>
 
 // Ref: https://iquilezles.org/articles/intersectors/
-NODISCARD bool Mesh::Triangle::Hit(const Mesh& mesh, const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+NODISCARD bool Mesh::Edges::Intersect(const Ray &ray, const Interval& interval, Real& t, Real& u, Real& v) const NOEXCEPT
 {
-    const Eigen::Vector3d& v1v0 = mesh.vertices[point[1].vertex] - mesh.vertices[point[0].vertex];
-    const Eigen::Vector3d& v2v0 = mesh.vertices[point[2].vertex] - mesh.vertices[point[0].vertex];
-    const Eigen::Vector3d rov0 = ray.origin - mesh.vertices[point[0].vertex];
-    const Eigen::Vector3d n = v1v0.cross(v2v0);
+    const Vector3r rov0 = ray.origin - v0;
+    const Vector3r n = e1.cross(e2);
 
-    const double rdn = ray.direction.dot(n);
+    const Real rdn = ray.direction.dot(n);
 
     if (FIsZero(rdn)) { return false; }
 
-    const Eigen::Vector3d q = rov0.cross(ray.direction);
-    const double d = 1.0 / rdn;
-    const double u = d * -q.dot(v2v0);
-    const double v = d * q.dot(v1v0);
-    const double w = 1.0 - u - v;
-    const double t = d * -n.dot(rov0);
+    const Vector3r q = rov0.cross(ray.direction);
+    const Real d = (Real)1.0 / rdn;
+    u = d * -q.dot(e2);
+    v = d * q.dot(e1);
+    t = d * -n.dot(rov0);
 
     if (!interval.Contain(t)) { return false; }
 
-    if (FIsNegative(u) || FIsNegative(v) || Fgt(u + v, 1.0)) { return false; }
+    return !(FIsNegative(u) || FIsNegative(v) || Fgt(u + v, 1.0));
+}
 
-    record.t = t;
-    record.hit_point = ray.At(t);
-    record.hit_normal = (u * mesh.normals[point[0].normal] + v * mesh.normals[point[1].normal] + w * mesh.normals[point[2].normal]).normalized();
-    record.texcoord = Eigen::Vector2d{u, v};
-    record.material = mesh.materials[material];
+NODISCARD bool Mesh::Triangle::Intersect(const Mesh& mesh, const Ray &ray, const Interval& interval, Real& t, Real& u, Real& v) const NOEXCEPT
+{
+    const Vector3r& v0 = mesh.vertices[point[0].vertex];
+    return Edges{ v0, mesh.vertices[point[1].vertex] - v0, mesh.vertices[point[2].vertex] - v0 }.Intersect(ray, interval, t, u, v);
+}
 
-    return true;
+NODISCARD AABB Mesh::Triangle::CreateBoundingBox(const Mesh& mesh) const NOEXCEPT
+{
+    const Vector3r& v0 = mesh.vertices[point[0].vertex];
+    const Vector3r& v1 = mesh.vertices[point[1].vertex];
+    const Vector3r& v2 = mesh.vertices[point[2].vertex];
+    return { v0.cwiseMin(v1).cwiseMin(v2), v0.cwiseMax(v1).cwiseMax(v2) };
 }
 
-NODISCARD bool Mesh::Shape::Hit(const Mesh& mesh, const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+namespace
+{
+
+std::vector<BVHBuilder::Primitive> CreatePrimitives(const Mesh& mesh) NOEXCEPT
 {
-    record.t = INF;
+    std::vector<BVHBuilder::Primitive> primitives(mesh.triangles.size());
+    Parallel::For(0, primitives.size(), THREAD_POOL.ThreadNumber(),
+        [&mesh, &primitives](size_t thread_begin, size_t thread_end)
+        {
+            for (size_t i = thread_begin; i < thread_end; ++i)
+            {
+                const AABB bounding_box = mesh.triangles[i].CreateBoundingBox(mesh);
+                auto& primitive = primitives[i];
+                primitive.bmin = bounding_box.bmin.cast<double>();
+                primitive.bmax = bounding_box.bmax.cast<double>();
+                primitive.center = (primitive.bmin + primitive.bmax) / 2.0;
+                primitive.index = (Eigen::Index)i;
+            }
+        }
+    );
+    return primitives;
+}
 
-    for (const auto& triangle : triangles)
+Ref<Texture2D<Vector3r>> CreateTexture(const std::string& texname, const double color[3]) NOEXCEPT
+{
+    if (texname.empty())
     {
-        if (HitRecord t_record; triangle.Hit(mesh, ray, interval, t_record))
+        return MakeRef<PureColorTexture2D>(Eigen::Vector3d{ color[0], color[1], color[2] }.cast<Real>());
+    }
+    return MakeRef<ImageTexture2D>(MakeRef<Image>(Image::From(texname.c_str())));
+}
+
+void CreateMaterials(Mesh& mesh, const std::vector<MeshCache::MaterialRecord>& records, const std::unordered_map<std::string, Ref<Texture2D<Vector3r>>>& lights) NOEXCEPT
+{
+    mesh.materials.resize(records.size());
+    #ifdef NDEBUG
+    Parallel::For(0, mesh.materials.size(), THREAD_POOL.ThreadNumber(), [&mesh, &records, &lights](size_t thread_begin, size_t thread_end) {
+        for (size_t i = thread_begin; i < thread_end; ++i)
+    #else
+        for (size_t i = 0; i < mesh.materials.size(); ++i)
+    #endif
         {
-            if (Fgt(record.t, t_record.t))
+            const auto& record = records[i];
+            Ref<Texture2D<Vector3r>> ambient_tex = CreateTexture(record.texnames[0], record.colors[0]);
+            Ref<Texture2D<Vector3r>> diffuse_tex = CreateTexture(record.texnames[1], record.colors[1]);
+            Ref<Texture2D<Vector3r>> specular_tex = CreateTexture(record.texnames[2], record.colors[2]);
+            Ref<Texture2D<Vector3r>> emission_tex = CreateTexture(record.texnames[3], record.colors[3]);
+
+            if (record.name.starts_with("light"))
             {
-                record = t_record;
+                ambient_tex = MakeRef<PureColorTexture2D>(Vector3r{ 0.00, 0.00, 0.00 });
+                diffuse_tex = MakeRef<PureColorTexture2D>(Vector3r{ 0.50, 0.50, 0.50 });
+                specular_tex = MakeRef<PureColorTexture2D>(Vector3r{ 0.00, 0.00, 0.00 });
+                emission_tex = lights.find(record.name)->second;
             }
+
+            mesh.materials[i] = MakeRef<BlinnPhongMaterial>(
+                2.0, ambient_tex, diffuse_tex, specular_tex, emission_tex
+            );
+        }
+    #ifdef NDEBUG
+    });
+    #endif
+
+    mesh.PackMaterials();
+}
+
+// Bounds Of The Triangle Parts On Each Side Of The Plane, From Its Vertices And Edge Crossings.
+void ClipTriangle(const Mesh& mesh, const BVHBuilder::Primitive& reference, const Eigen::Index axis, const double position, BVHBuilder::Primitive& left, BVHBuilder::Primitive& right) NOEXCEPT
+{
+    const Mesh::Triangle& triangle = mesh.triangles[reference.index];
+    left.bmin = right.bmin = Eigen::Vector3d::Constant(INF);
+    left.bmax = right.bmax = Eigen::Vector3d::Constant(-INF);
+    for (int i = 0; i < 3; ++i)
+    {
+        const Eigen::Vector3d v0 = mesh.vertices[triangle.point[i].vertex].cast<double>();
+        const Eigen::Vector3d v1 = mesh.vertices[triangle.point[(i + 1) % 3].vertex].cast<double>();
+        if (v0[axis] <= position)
+        {
+            left.bmin = left.bmin.cwiseMin(v0);
+            left.bmax = left.bmax.cwiseMax(v0);
+        }
+        if (v0[axis] >= position)
+        {
+            right.bmin = right.bmin.cwiseMin(v0);
+            right.bmax = right.bmax.cwiseMax(v0);
+        }
+        if ((v0[axis] < position && position < v1[axis]) || (v1[axis] < position && position < v0[axis]))
+        {
+            Eigen::Vector3d p = v0 + (position - v0[axis]) / (v1[axis] - v0[axis]) * (v1 - v0);
+            p[axis] = position;
+            left.bmin = left.bmin.cwiseMin(p);
+            left.bmax = left.bmax.cwiseMax(p);
+            right.bmin = right.bmin.cwiseMin(p);
+            right.bmax = right.bmax.cwiseMax(p);
         }
     }
+}
 
-    return !FIsInfinity(record.t);
 }
 
-NODISCARD bool Mesh::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+void Mesh::InitializeBVH(const BVHConfig& config) NOEXCEPT
 {
-    record.t = INF;
+    bvh = LinearBVH{};
+    bounding_box = AABB{};
 
-    for (const auto& shape : shapes)
+    if (triangles.empty()) UNLIKELY
     {
-        if (HitRecord t_record; shape.Hit(*this, ray, interval, t_record))
+        return;
+    }
+
+    std::vector<BVHBuilder::Primitive> primitives = CreatePrimitives(*this);
+
+    std::vector<Eigen::Index> order;
+    bvh = LinearBVH::Build(primitives, config, order,
+        [this](const BVHBuilder::Primitive& reference, const Eigen::Index axis, const double position, BVHBuilder::Primitive& left, BVHBuilder::Primitive& right)
+        {
+            ClipTriangle(*this, reference, axis, position, left, right);
+        }
+    );
+
+    // Reorder Triangles So That Each Leaf References A Contiguous Range.
+    std::vector<Triangle> ordered(triangles.size());
+    Parallel::For(0, order.size(), THREAD_POOL.ThreadNumber(),
+        [this, &ordered, &order](size_t thread_begin, size_t thread_end)
         {
-            if (Fgt(record.t, t_record.t))
+            for (size_t i = thread_begin; i < thread_end; ++i)
             {
-                record = t_record;
+                ordered[i] = triangles[order[i]];
             }
         }
+    );
+    triangles = std::move(ordered);
+
+    if (!material_ids.empty())
+    {
+        std::vector<uint16_t> t_material_ids(material_ids.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            t_material_ids[i] = material_ids[order[i]];
+        }
+        material_ids = std::move(t_material_ids);
     }
 
-    return !FIsInfinity(record.t);
+    UpdateEdges();
+
+    bounding_box = bvh.Bounds();
+}
+
+void Mesh::RefitBVH() NOEXCEPT
+{
+    // NOTE: InitializeBVH Resets bvh, Pass It A Copy Of The Config.
+    const BVHConfig config = bvh.config;
+
+    if (bvh.IsEmpty()) UNLIKELY
+    {
+        InitializeBVH(config);
+        return;
+    }
+
+    // Triangles Are Already In Build Order, So Primitive i Is Primitive i Of The Build.
+    bvh.Refit(CreatePrimitives(*this));
+
+    if (bvh.NeedsRebuild())
+    {
+        InitializeBVH(config);
+        return;
+    }
+
+    UpdateEdges();
+
+    bounding_box = bvh.Bounds();
 }
 
-NODISCARD Mesh Mesh::FromOBJ(const char* filename, const std::unordered_map<std::string, Ref<Texture2D<Eigen::Vector3d>>>& lights) NOEXCEPT
+void Mesh::UpdateEdges() NOEXCEPT
 {
+    if (!bvh.config.precompute_edges)
+    {
+        edges = Buffer<Edges>{};
+        return;
+    }
+
+    std::vector<Edges> t_edges(triangles.size());
+    Parallel::For(0, t_edges.size(), THREAD_POOL.ThreadNumber(),
+        [this, &t_edges](size_t thread_begin, size_t thread_end)
+        {
+            for (size_t i = thread_begin; i < thread_end; ++i)
+            {
+                const Triangle& triangle = triangles[i];
+                const Vector3r& v0 = vertices[triangle.point[0].vertex];
+                t_edges[i] = Edges{ v0, vertices[triangle.point[1].vertex] - v0, vertices[triangle.point[2].vertex] - v0 };
+            }
+        }
+    );
+    edges = std::move(t_edges);
+}
+
+void Mesh::PackMaterials() NOEXCEPT
+{
+    packed_materials.resize(materials.size());
+    for (size_t i = 0; i < materials.size(); ++i)
+    {
+        packed_materials[i] = PackedMaterial::From(materials[i].get());
+    }
+}
+
+NODISCARD Mesh::MemoryReport Mesh::Memory() const NOEXCEPT
+{
+    return MemoryReport{
+        vertices.size() * sizeof(Vector3r),
+        normals.size() * sizeof(Vector3r),
+        texcoords.size() * sizeof(Vector2r),
+        triangles.size() * sizeof(Triangle),
+        material_ids.size() * sizeof(uint16_t),
+        edges.size() * sizeof(Edges),
+        bvh.MemoryUsage(),
+    };
+}
+
+NODISCARD bool Mesh::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+{
+    const auto closest = [this, &ray, &record](const Eigen::Index index, Interval& t_interval, const Real t, const Real u, const Real v) -> bool
+    {
+        t_interval.imax = record.t = t;
+        record.primitive = index;
+        record.uv = Vector2r{u, v};
+        record.hittable = this;
+        record.instance = nullptr;
+        return true;
+    };
+
+    if (!edges.empty())
+    {
+        return bvh.Traverse(ray, interval, [this, &ray, &closest](const Eigen::Index index, Interval& t_interval) -> bool
+        {
+            Real t, u, v;
+            return edges[index].Intersect(ray, t_interval, t, u, v) && closest(index, t_interval, t, u, v);
+        });
+    }
+
+    return bvh.Traverse(ray, interval, [this, &ray, &closest](const Eigen::Index index, Interval& t_interval) -> bool
+    {
+        Real t, u, v;
+        return triangles[index].Intersect(*this, ray, t_interval, t, u, v) && closest(index, t_interval, t, u, v);
+    });
+}
+
+void Mesh::Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT
+{
+    const Triangle& triangle = triangles[record.primitive];
+    const Real u = record.uv.x(), v = record.uv.y(), w = (Real)1.0 - u - v;
+
+    // Intersect Measures u Along v1 - v0 And v Along v2 - v0.
+    interaction.hit_point = ray.At(record.t);
+    if (triangle.point[0].normal >= 0 && triangle.point[1].normal >= 0 && triangle.point[2].normal >= 0)
+    {
+        interaction.hit_normal = (w * normals[triangle.point[0].normal] + u * normals[triangle.point[1].normal] + v * normals[triangle.point[2].normal]).normalized();
+    }
+    else
+    {
+        const Vector3r& v0 = vertices[triangle.point[0].vertex];
+        interaction.hit_normal = (vertices[triangle.point[1].vertex] - v0).cross(vertices[triangle.point[2].vertex] - v0).normalized();
+    }
+    if (triangle.point[0].texcoord >= 0 && triangle.point[1].texcoord >= 0 && triangle.point[2].texcoord >= 0)
+    {
+        interaction.texcoord = w * texcoords[triangle.point[0].texcoord] + u * texcoords[triangle.point[1].texcoord] + v * texcoords[triangle.point[2].texcoord];
+    }
+    else
+    {
+        interaction.texcoord = record.uv;
+    }
+    interaction.material = &packed_materials[material_ids.empty() ? 0 : material_ids[record.primitive]];
+}
+
+NODISCARD bool Mesh::Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT
+{
+    if (!edges.empty())
+    {
+        return bvh.Traverse<true>(ray, interval, [this, &ray](const Eigen::Index index, const Interval& t_interval) -> bool
+        {
+            Real t, u, v;
+            return edges[index].Intersect(ray, t_interval, t, u, v);
+        });
+    }
+
+    return bvh.Traverse<true>(ray, interval, [this, &ray](const Eigen::Index index, const Interval& t_interval) -> bool
+    {
+        Real t, u, v;
+        return triangles[index].Intersect(*this, ray, t_interval, t, u, v);
+    });
+}
+
+NODISCARD Mesh Mesh::FromOBJ(const char* filename, const std::unordered_map<std::string, Ref<Texture2D<Vector3r>>>& lights, const BVHConfig& config, const bool cache) NOEXCEPT
+{
+    Mesh mesh;
+    std::vector<MeshCache::MaterialRecord> records;
+
+    // Geometry And BVH Come Straight From The Mapped Cache, Only The Few Materials Are Rebuilt.
+    if (cache && MeshCache::Load(filename, config, mesh, records))
+    {
+        CreateMaterials(mesh, records, lights);
+        mesh.UpdateEdges();
+        return mesh;
+    }
+
     tinyobj::ObjReader reader;
     if (!reader.ParseFromFile(filename))
     {
@@ -102,8 +373,6 @@ NODISCARD Mesh Mesh::FromOBJ(const char* filename, const std::unordered_map<std:
         exit(1);
     }
 
-    Mesh mesh;
-
     const auto& attrib = reader.GetAttrib();
 
     ASSERT(attrib.vertices.size() % 3 == 0);
@@ -114,9 +383,9 @@ NODISCARD Mesh Mesh::FromOBJ(const char* filename, const std::unordered_map<std:
             for (size_t i = thread_begin, j = 3 * thread_begin; i < thread_end; ++i, j += 3)
             {
                 auto& vertex = mesh.vertices[i];
-                vertex.x() = attrib.vertices[j];
-                vertex.y() = attrib.vertices[j + 1];
-                vertex.z() = attrib.vertices[j + 2];
+                vertex.x() = (Real)attrib.vertices[j];
+                vertex.y() = (Real)attrib.vertices[j + 1];
+                vertex.z() = (Real)attrib.vertices[j + 2];
             }
         }
     );
@@ -129,9 +398,9 @@ NODISCARD Mesh Mesh::FromOBJ(const char* filename, const std::unordered_map<std:
             for (size_t i = thread_begin, j = 3 * thread_begin; i < thread_end; ++i, j += 3)
             {
                 auto& normal = mesh.normals[i];
-                normal.x() = attrib.normals[j];
-                normal.y() = attrib.normals[j + 1];
-                normal.z() = attrib.normals[j + 2];
+                normal.x() = (Real)attrib.normals[j];
+                normal.y() = (Real)attrib.normals[j + 1];
+                normal.z() = (Real)attrib.normals[j + 2];
             }
         }
     );
@@ -144,135 +413,91 @@ NODISCARD Mesh Mesh::FromOBJ(const char* filename, const std::unordered_map<std:
             for (size_t i = thread_begin, j = (thread_begin << 1); i < thread_end; ++i, j += 2)
             {
                 auto& texcoord = mesh.texcoords[i];
-                texcoord.x() = attrib.texcoords[j];
-                texcoord.y() = attrib.texcoords[j + 1];
+                texcoord.x() = (Real)attrib.texcoords[j];
+                texcoord.y() = (Real)attrib.texcoords[j + 1];
             }
         }
     );
 
     const auto& materials = reader.GetMaterials();
-    mesh.materials.resize(materials.size());
-    #ifdef NDEBUG
-    Parallel::For(0, mesh.materials.size(), THREAD_POOL.ThreadNumber(), [&mesh, &materials, &lights](size_t thread_begin, size_t thread_end) {
-        for (size_t i = thread_begin; i < thread_end; ++i)
-    #else
-        for (size_t i = 0; i < mesh.materials.size(); ++i)
-    #endif
+    records.resize(materials.size());
+    for (size_t i = 0; i < materials.size(); ++i)
+    {
+        const auto& t_material = materials[i];
+        auto& record = records[i];
+        record.name = t_material.name;
+        record.texnames[0] = t_material.ambient_texname;
+        record.texnames[1] = t_material.diffuse_texname;
+        record.texnames[2] = t_material.specular_texname;
+        record.texnames[3] = t_material.emissive_texname;
+        for (int k = 0; k < 3; ++k)
         {
-            const auto& t_material = materials[i];
-            Ref<Texture2D<Eigen::Vector3d>> ambient_tex = nullptr;
-            Ref<Texture2D<Eigen::Vector3d>> diffuse_tex = nullptr;
-            Ref<Texture2D<Eigen::Vector3d>> specular_tex = nullptr;
-            Ref<Texture2D<Eigen::Vector3d>> emission_tex = nullptr;
-
-            if (t_material.ambient_texname.empty())
-            {
-                ambient_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{
-                    t_material.ambient[0],
-                    t_material.ambient[1],
-                    t_material.ambient[2]
-                });
-            }
-            else
-            {
-                ambient_tex = MakeRef<ImageTexture2D>(
-                    MakeRef<Image>(Image::From(t_material.ambient_texname.c_str()))
-                );
-            }
-
-            if (t_material.diffuse_texname.empty())
-            {
-                diffuse_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{
-                    t_material.diffuse[0],
-                    t_material.diffuse[1],
-                    t_material.diffuse[2]
-                });
-            }
-            else
-            {
-                diffuse_tex = MakeRef<ImageTexture2D>(
-                    MakeRef<Image>(Image::From(t_material.diffuse_texname.c_str()))
-                );
-            }
-
-            if (t_material.specular_texname.empty())
-            {
-                specular_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{
-                    t_material.specular[0],
-                    t_material.specular[1],
-                    t_material.specular[2]
-                });
-            }
-            else
-            {
-                specular_tex = MakeRef<ImageTexture2D>(
-                    MakeRef<Image>(Image::From(t_material.specular_texname.c_str()))
-                );
-            }
-
-            if (t_material.emissive_texname.empty())
-            {
-                emission_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{
-                    t_material.emission[0],
-                    t_material.emission[1],
-                    t_material.emission[2]
-                });
-            }
-            else
-            {
-                emission_tex = MakeRef<ImageTexture2D>(
-                    MakeRef<Image>(Image::From(t_material.emissive_texname.c_str()))
-                );
-            }
-
-            if (t_material.name.starts_with("light"))
-            {
-                ambient_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{ 0.00, 0.00, 0.00 });
-                diffuse_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{ 0.50, 0.50, 0.50 });
-                specular_tex = MakeRef<PureColorTexture2D>(Eigen::Vector3d{ 0.00, 0.00, 0.00 });
-                emission_tex = lights.find(t_material.name)->second;
-            }
-
-            mesh.materials[i] = MakeRef<BlinnPhongMaterial>(
-                2.0, ambient_tex, diffuse_tex, specular_tex, emission_tex
-            );
+            record.colors[0][k] = t_material.ambient[k];
+            record.colors[1][k] = t_material.diffuse[k];
+            record.colors[2][k] = t_material.specular[k];
+            record.colors[3][k] = t_material.emission[k];
         }
-    #ifdef NDEBUG
-    });
-    #endif
+    }
+    CreateMaterials(mesh, records, lights);
 
     const auto& shapes = reader.GetShapes();
-    mesh.shapes.reserve(shapes.size());
 
+    size_t triangle_count = 0;
     for (const auto& shape : shapes)
     {
-        // Triangulation Enabled. Ignore Points. Ignore Lines.
-        Mesh::Shape t_shape;
-        t_shape.name = shape.name;
-
         ASSERT(shape.mesh.indices.size() % 3 == 0);
         ASSERT(shape.mesh.material_ids.size() == shape.mesh.indices.size() / 3);
+        triangle_count += shape.mesh.indices.size() / 3;
+    }
+    mesh.triangles.resize(triangle_count);
+
+    // Index And Material Id Widths, See Mesh::Index And Mesh::material_ids.
+    if (std::max({ mesh.vertices.size(), mesh.normals.size(), mesh.texcoords.size() }) > (size_t)std::numeric_limits<int32_t>::max())
+    {
+        FATAL("Too Many Vertices For 32 Bit Indices\n");
+    }
+    if (mesh.materials.size() > (size_t)std::numeric_limits<uint16_t>::max() + 1)
+    {
+        FATAL("Too Many Materials For 16 Bit Material Ids\n");
+    }
+    std::vector<uint16_t> material_ids(triangle_count);
 
-        t_shape.triangles.resize(shape.mesh.indices.size() / 3);
-        Parallel::For(0, t_shape.triangles.size(), THREAD_POOL.ThreadNumber(),
-            [&t_shape, &shape](size_t thread_begin, size_t thread_end)
+    for (size_t offset = 0; const auto& shape : shapes)
+    {
+        // Triangulation Enabled. Ignore Points. Ignore Lines.
+        Parallel::For(0, shape.mesh.indices.size() / 3, THREAD_POOL.ThreadNumber(),
+            [&mesh, &material_ids, &shape, offset](size_t thread_begin, size_t thread_end)
             {
                 for (size_t i = thread_begin, j = 3 * thread_begin; i < thread_end; ++i, j+=3)
                 {
+                    auto& triangle = mesh.triangles[offset + i];
                     for (size_t k = 0; k < 3; ++k)
                     {
-                        auto& triangle_v = t_shape.triangles[i].point[k];
+                        auto& triangle_v = triangle.point[k];
                         const auto& mesh_index = shape.mesh.indices[j + k];
-                        triangle_v.vertex = mesh_index.vertex_index;
-                        triangle_v.normal = mesh_index.normal_index;
-                        triangle_v.texcoord = mesh_index.texcoord_index;
+                        triangle_v.vertex = (int32_t)mesh_index.vertex_index;
+                        triangle_v.normal = (int32_t)mesh_index.normal_index;
+                        triangle_v.texcoord = (int32_t)mesh_index.texcoord_index;
                     }
-                    t_shape.triangles[i].material = shape.mesh.material_ids[i];
+                    material_ids[offset + i] = (uint16_t)shape.mesh.material_ids[i];
                 }
             }
         );
 
-        mesh.shapes.emplace_back(t_shape);
+        offset += shape.mesh.indices.size() / 3;
+    }
+
+    // Single Material Meshes Skip The Ids.
+    if (std::any_of(material_ids.begin(), material_ids.end(), [](const uint16_t id) { return id != 0; }))
+    {
+        mesh.material_ids = std::move(material_ids);
+    }
+
+    mesh.InitializeBVH(config);
+
+    if (cache && !MeshCache::Store(filename, config, mesh, records))
+    {
+        fmt::fprintf(stderr, "Failed To Write %s\n", MeshCache::PathOf(filename).c_str()); fflush(stderr);
     }
 
     return mesh;
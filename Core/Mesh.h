@@ -16,6 +16,7 @@
 #include <Core/Common.h>
 #include <Core/Hittable.h>
 #include <Core/Material.h>
+#include <Core/LinearBVH.h>
 
 struct Mesh final : Hittable
 {
@@ -23,47 +24,72 @@ struct Mesh final : Hittable
 
     NODISCARD explicit Mesh() NOEXCEPT : Hittable(HITTABLE_KIND_MESH) {}
 
-    struct Index // Per Vertex.
+    struct Index // Per Vertex. -1 Where The OBJ Has No Normal Or Texcoord.
     {
-        Eigen::Index vertex;
-        Eigen::Index normal;
-        Eigen::Index texcoord;
+        int32_t vertex;
+        int32_t normal;
+        int32_t texcoord;
     };
 
-    struct Triangle // Three Vertex + One Material.
+    struct Triangle // Three Vertex. 36 Bytes, Material Ids Live In material_ids.
     {
         Index point[3];
-        Eigen::Index material;
 
-        NODISCARD bool Hit(const Mesh& mesh, const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT;
+        NODISCARD AABB CreateBoundingBox(const Mesh& mesh) const NOEXCEPT;
+        NODISCARD bool Intersect(const Mesh& mesh, const Ray &ray, const Interval& interval, Real& t, Real& u, Real& v) const NOEXCEPT;
     };
 
-    struct Shape
+    struct Edges // Per Triangle, Saves Three Vertex Lookups Per Test.
     {
-        std::string name;
-        std::vector<Triangle> triangles;
+        Vector3r v0;
+        Vector3r e1; // v1 - v0.
+        Vector3r e2; // v2 - v0.
 
-        NODISCARD bool Hit(const Mesh& mesh, const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT;
+        NODISCARD bool Intersect(const Ray &ray, const Interval& interval, Real& t, Real& u, Real& v) const NOEXCEPT;
     };
 
-    std::vector<Eigen::Vector3d> vertices;
-    std::vector<Eigen::Vector3d> normals;
-    std::vector<Eigen::Vector2d> texcoords;
-    std::vector<Ref<Material>> materials;
+    struct MemoryReport // Bytes.
+    {
+        size_t vertices;
+        size_t normals;
+        size_t texcoords;
+        size_t triangles;
+        size_t material_ids;
+        size_t edges;
+        size_t bvh;
+
+        NODISCARD size_t Total() const NOEXCEPT { return vertices + normals + texcoords + triangles + material_ids + edges + bvh; }
+    };
 
-    std::vector<Shape> shapes;
+    Buffer<Vector3r> vertices; // Buffers Point Into The Cache File When Loaded From It.
+    Buffer<Vector3r> normals;
+    Buffer<Vector2r> texcoords;
+    std::vector<Ref<Material>> materials;         // At Most 65536.
+    std::vector<PackedMaterial> packed_materials; // Same Order, See PackMaterials.
 
-    Ref<BoundingBox> bb;
+    Buffer<Triangle> triangles;    // All Shapes. Reordered By InitializeBVH.
+    Buffer<uint16_t> material_ids; // Per Triangle, Same Order. Empty When All Triangles Use materials[0].
+    Buffer<Edges> edges;           // Per Triangle, Same Order. Empty Unless BVHConfig::precompute_edges.
+    LinearBVH bvh;
 
-    NODISCARD const Ref<BoundingBox> &GetBoundingBox() const NOEXCEPT OVERRIDE
-    {
-        // TODO: BVH.
-        return bb;
-    }
+    void InitializeBVH(const BVHConfig& config = {}) NOEXCEPT;
+    // Call After Moving Vertices. Topology Must Be Unchanged. Falls Back To A Full Build Once The Tree Degrades.
+    void RefitBVH() NOEXCEPT;
+    // Rebuilds Or Drops edges Following bvh.config. InitializeBVH And RefitBVH Call It.
+    void UpdateEdges() NOEXCEPT;
+
+    // Call After Changing materials. FromOBJ Calls It.
+    void PackMaterials() NOEXCEPT;
+
+    NODISCARD MemoryReport Memory() const NOEXCEPT;
 
     NODISCARD bool Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT OVERRIDE;
+    NODISCARD bool Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT OVERRIDE;
+    // Interpolates Vertex Normals And Texcoords Where The OBJ Has Them, Falls Back To The Face Normal And Barycentrics.
+    void Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT OVERRIDE;
 
-    NODISCARD static Mesh FromOBJ(const char* filename, const std::unordered_map<std::string, Ref<Texture2D<Eigen::Vector3d>>>& lights) NOEXCEPT;
+    // cache: Load From And Store To <filename>.cache, See MeshCache.
+    NODISCARD static Mesh FromOBJ(const char* filename, const std::unordered_map<std::string, Ref<Texture2D<Vector3r>>>& lights, const BVHConfig& config = {}, bool cache = true) NOEXCEPT;
 };
 
 #endif //MESH_H
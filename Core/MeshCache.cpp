@@ -0,0 +1,448 @@
+/**
+  ******************************************************************************
+  * @file           : MeshCache.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-29
+  ******************************************************************************
+  */
+
+
+
+#include <Core/MeshCache.h>
+#include <Core/Mesh.h>
+#include <Core/MappedFile.h>
+
+#include <bit>
+#include <cstring>
+#include <string_view>
+
+namespace
+{
+
+CONSTEXPR char MAGIC[8] = { 'P', 'T', 'C', 'A', 'C', 'H', 'E', '\0' };
+CONSTEXPR uint64_t ALIGNMENT = 64; // Cache Line, Also alignof(WideBVHNode).
+
+enum SectionKind : uint32_t
+{
+    SECTION_VERTICES,
+    SECTION_NORMALS,
+    SECTION_TEXCOORDS,
+    SECTION_TRIANGLES,
+    SECTION_MATERIAL_IDS,
+    SECTION_REFERENCES,
+    SECTION_NODES,
+    SECTION_WIDE4_NODES,
+    SECTION_WIDE8_NODES,
+    SECTION_QUANTIZED8_NODES,
+    SECTION_QUANTIZED16_NODES,
+    SECTION_MATERIALS,    // Byte Blob Of MaterialRecord.
+    SECTION_DEPENDENCIES, // Byte Blob Of Material Library Stamps.
+    SECTION_COUNT,
+};
+
+CONSTEXPR uint32_t ELEMENT_SIZES[SECTION_COUNT] = {
+    sizeof(Vector3r),
+    sizeof(Vector3r),
+    sizeof(Vector2r),
+    sizeof(Mesh::Triangle),
+    sizeof(uint16_t),
+    sizeof(uint32_t),
+    sizeof(LinearBVHNode),
+    sizeof(WideBVHNode<4>),
+    sizeof(WideBVHNode<8>),
+    sizeof(QuantizedBVHNode<8, uint8_t>),
+    sizeof(QuantizedBVHNode<8, uint16_t>),
+    1,
+    1,
+};
+
+struct Section
+{
+    uint64_t offset; // Multiple Of ALIGNMENT.
+    uint64_t count;  // Elements, Not Bytes.
+};
+
+struct Header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t element_sizes[SECTION_COUNT]; // Catches Layout Changes Between Builds.
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t source_hash;
+    uint64_t config_hash;
+    Section sections[SECTION_COUNT];
+    double bmin[3];
+    double bmax[3];
+    double build_cost;
+    double cost;
+    BVHStatistics statistics;
+};
+
+static_assert(std::is_trivially_copyable_v<Header>);
+
+struct FileStamp
+{
+    uint64_t size;
+    int64_t mtime;
+};
+
+NODISCARD bool Stamp(const FS::path& path, FileStamp& stamp) NOEXCEPT
+{
+    std::error_code ec;
+    stamp.size = (uint64_t)FS::file_size(path, ec);
+    if (ec) { return false; }
+    stamp.mtime = (int64_t)FS::last_write_time(path, ec).time_since_epoch().count();
+    return !ec;
+}
+
+// A Missing File Gets A Stamp No Existing File Has, The Cache Goes Stale Once It Appears.
+NODISCARD FileStamp LibraryStamp(const FS::path& path) NOEXCEPT
+{
+    FileStamp stamp;
+    if (!Stamp(path, stamp)) { stamp = { std::numeric_limits<uint64_t>::max(), 0 }; }
+    return stamp;
+}
+
+// Multiply Rotate Hash Over Four Independent Lanes, Fast Enough To Run Over The Source On Every Load.
+NODISCARD uint64_t Hash(const uint8_t* data, const size_t size) NOEXCEPT
+{
+    CONSTEXPR uint64_t P1 = 0x9E3779B185EBCA87ull;
+    CONSTEXPR uint64_t P2 = 0xC2B2AE3D27D4EB4Full;
+
+    uint64_t lanes[4] = { P1 + P2, P2, 0, 0 - P1 };
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        for (int k = 0; k < 4; ++k)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + i + 8 * k, sizeof(word));
+            lanes[k] = std::rotl(lanes[k] + word * P2, 31) * P1;
+        }
+    }
+
+    uint64_t hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+    for (; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * P1;
+    }
+    hash ^= (uint64_t)size;
+    hash ^= hash >> 33;
+    hash *= P2;
+    hash ^= hash >> 29;
+    hash *= P1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// Only The Fields That Shape The Tree. rebuild_threshold Is Taken From The Caller On Load.
+NODISCARD uint64_t ConfigHash(const BVHConfig& config) NOEXCEPT
+{
+    const double fields[] = {
+        (double)config.layout,
+        (double)config.bin_count,
+        (double)config.max_leaf_size,
+        config.traversal_cost,
+        config.intersection_cost,
+        (double)config.spatial_splits,
+        config.spatial_split_alpha,
+        config.spatial_split_budget,
+        (double)config.treelet_optimization,
+        (double)config.treelet_size,
+        (double)config.treelet_passes,
+    };
+    return Hash((const uint8_t*)fields, sizeof(fields));
+}
+
+// Material Libraries Named By mtllib, Resolved Against The Directory Of The Source Like tinyobjloader Does.
+NODISCARD std::vector<FS::path> MaterialLibraries(const MappedFile& source, const FS::path& directory) NOEXCEPT
+{
+    std::vector<FS::path> libraries;
+    const std::string_view text((const char*)source.Bytes(), source.size);
+    for (size_t begin = 0; begin < text.size();)
+    {
+        size_t end = text.find('\n', begin);
+        if (end == std::string_view::npos) { end = text.size(); }
+        std::string_view line = text.substr(begin, end - begin);
+        begin = end + 1;
+
+        const size_t first = line.find_first_not_of(" \t");
+        if (first == std::string_view::npos) { continue; }
+        line.remove_prefix(first);
+        if (!line.starts_with("mtllib") || line.size() < 7 || (line[6] != ' ' && line[6] != '\t')) { continue; }
+        line.remove_prefix(7);
+
+        while (!line.empty())
+        {
+            const size_t name_begin = line.find_first_not_of(" \t\r");
+            if (name_begin == std::string_view::npos) { break; }
+            line.remove_prefix(name_begin);
+            const size_t name_end = std::min(line.find_first_of(" \t\r"), line.size());
+            libraries.push_back(directory / FS::path(std::string(line.substr(0, name_end))));
+            line.remove_prefix(name_end);
+        }
+    }
+    return libraries;
+}
+
+struct BlobWriter
+{
+    std::vector<uint8_t> bytes;
+
+    template<typename T>
+    void Write(const T& value) NOEXCEPT
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const uint8_t* data = (const uint8_t*)&value;
+        bytes.insert(bytes.end(), data, data + sizeof(T));
+    }
+
+    void Write(const std::string& value) NOEXCEPT
+    {
+        Write((uint32_t)value.size());
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+};
+
+struct BlobReader
+{
+    const uint8_t* data;
+    size_t size;
+    size_t position = 0;
+    bool ok = true; // Sticky, Checked Once After Reading Everything.
+
+    template<typename T>
+    void Read(T& value) NOEXCEPT
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (!ok || size - position < sizeof(T)) { ok = false; return; }
+        std::memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+    }
+
+    void Read(std::string& value) NOEXCEPT
+    {
+        uint32_t length = 0;
+        Read(length);
+        if (!ok || size - position < length) { ok = false; return; }
+        value.assign((const char*)data + position, length);
+        position += length;
+    }
+};
+
+}
+
+NODISCARD std::string MeshCache::PathOf(const char* filename) NOEXCEPT
+{
+    #ifdef REAL_FLOAT
+    return std::string(filename) + ".f32.cache";
+    #else
+    return std::string(filename) + ".cache";
+    #endif
+}
+
+NODISCARD bool MeshCache::Load(const char* filename, const BVHConfig& config, Mesh& mesh, std::vector<MaterialRecord>& materials) NOEXCEPT
+{
+    FileStamp stamp;
+    if (!Stamp(filename, stamp)) { return false; }
+
+    const Ref<MappedFile> cache = MappedFile::Open(PathOf(filename).c_str());
+    if (cache == nullptr || cache->size < sizeof(Header)) { return false; }
+
+    Header header;
+    std::memcpy(&header, cache->Bytes(), sizeof(Header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION ||
+        std::memcmp(header.element_sizes, ELEMENT_SIZES, sizeof(ELEMENT_SIZES)) != 0 ||
+        header.source_size != stamp.size ||
+        header.source_mtime != stamp.mtime ||
+        header.config_hash != ConfigHash(config))
+    {
+        return false;
+    }
+
+    for (uint32_t s = 0; s < SECTION_COUNT; ++s)
+    {
+        const Section& section = header.sections[s];
+        if (section.offset % ALIGNMENT != 0 || section.offset > cache->size || section.count > (cache->size - section.offset) / ELEMENT_SIZES[s])
+        {
+            return false;
+        }
+    }
+
+    const auto blob = [&cache, &header](const SectionKind kind) -> BlobReader
+    {
+        return BlobReader{ cache->Bytes() + header.sections[kind].offset, header.sections[kind].count };
+    };
+
+    BlobReader dependencies = blob(SECTION_DEPENDENCIES);
+    uint32_t dependency_count = 0;
+    dependencies.Read(dependency_count);
+    for (uint32_t i = 0; i < dependency_count && dependencies.ok; ++i)
+    {
+        std::string path;
+        FileStamp expected = {};
+        dependencies.Read(path);
+        dependencies.Read(expected);
+        if (!dependencies.ok) { break; }
+        const FileStamp actual = LibraryStamp(path);
+        if (actual.size != expected.size || actual.mtime != expected.mtime) { return false; }
+    }
+    if (!dependencies.ok) { return false; }
+
+    // Size And Time Match Already, The Hash Catches Edits That Keep Both.
+    {
+        const Ref<MappedFile> source = MappedFile::Open(filename);
+        if (source == nullptr || Hash(source->Bytes(), source->size) != header.source_hash) { return false; }
+    }
+
+    BlobReader records = blob(SECTION_MATERIALS);
+    uint32_t material_count = 0;
+    records.Read(material_count);
+    std::vector<MaterialRecord> t_materials;
+    for (uint32_t i = 0; i < material_count && records.ok; ++i)
+    {
+        MaterialRecord& record = t_materials.emplace_back();
+        records.Read(record.name);
+        for (int k = 0; k < 4; ++k) { records.Read(record.texnames[k]); }
+        records.Read(record.colors);
+    }
+    if (!records.ok) { return false; }
+
+    const auto buffer = [&cache, &header]<typename T>(Buffer<T>& target, const SectionKind kind)
+    {
+        target = Buffer<T>(cache, header.sections[kind].offset, header.sections[kind].count);
+    };
+
+    buffer(mesh.vertices, SECTION_VERTICES);
+    buffer(mesh.normals, SECTION_NORMALS);
+    buffer(mesh.texcoords, SECTION_TEXCOORDS);
+    buffer(mesh.triangles, SECTION_TRIANGLES);
+    buffer(mesh.material_ids, SECTION_MATERIAL_IDS);
+
+    mesh.bvh = LinearBVH{};
+    mesh.bvh.config = config;
+    buffer(mesh.bvh.references, SECTION_REFERENCES);
+    buffer(mesh.bvh.nodes, SECTION_NODES);
+    buffer(mesh.bvh.wide4.nodes, SECTION_WIDE4_NODES);
+    buffer(mesh.bvh.wide8.nodes, SECTION_WIDE8_NODES);
+    buffer(mesh.bvh.quantized8.nodes, SECTION_QUANTIZED8_NODES);
+    buffer(mesh.bvh.quantized16.nodes, SECTION_QUANTIZED16_NODES);
+    mesh.bvh.bmin = Eigen::Vector3d{ header.bmin[0], header.bmin[1], header.bmin[2] };
+    mesh.bvh.bmax = Eigen::Vector3d{ header.bmax[0], header.bmax[1], header.bmax[2] };
+    mesh.bvh.statistics = header.statistics;
+    mesh.bvh.build_cost = header.build_cost;
+    mesh.bvh.cost = header.cost;
+    mesh.bounding_box = mesh.bvh.IsEmpty() ? AABB{} : mesh.bvh.Bounds();
+
+    materials = std::move(t_materials);
+    return true;
+}
+
+NODISCARD bool MeshCache::Store(const char* filename, const BVHConfig& config, const Mesh& mesh, const std::vector<MaterialRecord>& materials) NOEXCEPT
+{
+    FileStamp stamp;
+    const Ref<MappedFile> source = MappedFile::Open(filename);
+    if (source == nullptr || !Stamp(filename, stamp)) { return false; }
+
+    // Zeroed So Padding Bytes Are Deterministic.
+    Header header;
+    std::memset((void*)&header, 0, sizeof(Header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    std::memcpy(header.element_sizes, ELEMENT_SIZES, sizeof(ELEMENT_SIZES));
+    header.source_size = stamp.size;
+    header.source_mtime = stamp.mtime;
+    header.source_hash = Hash(source->Bytes(), source->size);
+    header.config_hash = ConfigHash(config);
+    for (int a = 0; a < 3; ++a)
+    {
+        header.bmin[a] = mesh.bvh.bmin[a];
+        header.bmax[a] = mesh.bvh.bmax[a];
+    }
+    header.build_cost = mesh.bvh.build_cost;
+    header.cost = mesh.bvh.cost;
+    header.statistics = mesh.bvh.statistics;
+
+    BlobWriter records;
+    records.Write((uint32_t)materials.size());
+    for (const MaterialRecord& record : materials)
+    {
+        records.Write(record.name);
+        for (int k = 0; k < 4; ++k) { records.Write(record.texnames[k]); }
+        records.Write(record.colors);
+    }
+
+    BlobWriter dependencies;
+    const std::vector<FS::path> libraries = MaterialLibraries(*source, FS::path(filename).parent_path());
+    dependencies.Write((uint32_t)libraries.size());
+    for (const FS::path& library : libraries)
+    {
+        dependencies.Write(library.string());
+        dependencies.Write(LibraryStamp(library));
+    }
+
+    struct Payload
+    {
+        const void* data;
+        size_t count;
+    };
+
+    const Payload payloads[SECTION_COUNT] = {
+        { mesh.vertices.data(), mesh.vertices.size() },
+        { mesh.normals.data(), mesh.normals.size() },
+        { mesh.texcoords.data(), mesh.texcoords.size() },
+        { mesh.triangles.data(), mesh.triangles.size() },
+        { mesh.material_ids.data(), mesh.material_ids.size() },
+        { mesh.bvh.references.data(), mesh.bvh.references.size() },
+        { mesh.bvh.nodes.data(), mesh.bvh.nodes.size() },
+        { mesh.bvh.wide4.nodes.data(), mesh.bvh.wide4.nodes.size() },
+        { mesh.bvh.wide8.nodes.data(), mesh.bvh.wide8.nodes.size() },
+        { mesh.bvh.quantized8.nodes.data(), mesh.bvh.quantized8.nodes.size() },
+        { mesh.bvh.quantized16.nodes.data(), mesh.bvh.quantized16.nodes.size() },
+        { records.bytes.data(), records.bytes.size() },
+        { dependencies.bytes.data(), dependencies.bytes.size() },
+    };
+
+    uint64_t offset = sizeof(Header);
+    for (uint32_t s = 0; s < SECTION_COUNT; ++s)
+    {
+        offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        header.sections[s] = Section{ offset, payloads[s].count };
+        offset += payloads[s].count * ELEMENT_SIZES[s];
+    }
+
+    // Unique Per Writer, Concurrent Renders Of The Same Scene May Both Store.
+    const std::string path = PathOf(filename);
+    const std::string temporary = fmt::format("{}.{:08x}.tmp", path, std::random_device{}());
+
+    FILE* fp = fopen(temporary.c_str(), "wb");
+    if (fp == nullptr) { return false; }
+
+    static CONSTEXPR uint8_t ZEROS[ALIGNMENT] = {};
+    bool ok = fwrite(&header, sizeof(Header), 1, fp) == 1;
+    uint64_t position = sizeof(Header);
+    for (uint32_t s = 0; s < SECTION_COUNT && ok; ++s)
+    {
+        if (payloads[s].count == 0) { continue; }
+        const size_t padding = (size_t)(header.sections[s].offset - position);
+        ok = fwrite(ZEROS, 1, padding, fp) == padding && fwrite(payloads[s].data, ELEMENT_SIZES[s], payloads[s].count, fp) == payloads[s].count;
+        position = header.sections[s].offset + payloads[s].count * ELEMENT_SIZES[s];
+    }
+    ok = fclose(fp) == 0 && ok;
+
+    std::error_code ec;
+    if (ok)
+    {
+        FS::rename(temporary, path, ec);
+    }
+    if (!ok || ec)
+    {
+        FS::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file           : MeshCache.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-29
+  ******************************************************************************
+  */
+
+
+
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <Core/Common.h>
+#include <Core/BVHBuilder.h>
+
+struct Mesh;
+
+// Versioned Binary Cache Of A Parsed Mesh And Its BVH, Stored Next To The Source As <filename>.cache
+// (<filename>.f32.cache For REAL_FLOAT Builds, So Both Builds Keep Their Own).
+// Arrays Are Stored Exactly As In Memory, Loading Maps The File And Points The Mesh Buffers Into It.
+// Mesh::edges Is Not Stored, It Is Cheap To Rebuild And Depends On BVHConfig::precompute_edges Only.
+// Keyed On The Size, Modification Time And Content Hash Of The Source And Its Material Libraries, And On The BVH Config.
+struct MeshCache
+{
+    static CONSTEXPR uint32_t VERSION = 3;
+
+    // Enough Of An OBJ Material To Rebuild It. Textures Are Loaded Again From Their Files.
+    struct MaterialRecord
+    {
+        std::string name;
+        std::string texnames[4]; // Ambient, Diffuse, Specular, Emission.
+        double colors[4][3];     // Same Order, Used Where The Texture Name Is Empty.
+    };
+
+    NODISCARD static std::string PathOf(const char* filename) NOEXCEPT;
+
+    // Fails Without Touching mesh If The Cache Is Missing, Stale Or Written By Another Version.
+    NODISCARD static bool Load(const char* filename, const BVHConfig& config, Mesh& mesh, std::vector<MaterialRecord>& materials) NOEXCEPT;
+
+    // Writes A Temporary File And Renames It, Readers Never See A Partial Cache.
+    NODISCARD static bool Store(const char* filename, const BVHConfig& config, const Mesh& mesh, const std::vector<MaterialRecord>& materials) NOEXCEPT;
+};
+
+#endif //MESH_CACHE_H
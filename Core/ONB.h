@@ -17,18 +17,18 @@
 
 struct ONB
 {
-    Eigen::Vector3d x, y, z;
+    Vector3r x, y, z;
 
-    NODISCARD explicit ONB(const Eigen::Vector3d& direction) NOEXCEPT
+    NODISCARD explicit ONB(const Vector3r& direction) NOEXCEPT
     {
         x = direction;
-        z = x.cross(Eigen::Vector3d{ 0.0, 1.0, 0.0 });
-        if (FIsZero(z.norm())) { z = x.cross(Eigen::Vector3d{ 1.0, 0.0, 0.0 }); }
+        z = x.cross(Vector3r{ 0.0, 1.0, 0.0 });
+        if (FIsZero(z.norm())) { z = x.cross(Vector3r{ 1.0, 0.0, 0.0 }); }
         z.normalize();
         y = z.cross(x);
     }
 
-    NODISCARD ONB(const Eigen::Vector3d& direction, const Eigen::Vector3d& up) NOEXCEPT
+    NODISCARD ONB(const Vector3r& direction, const Vector3r& up) NOEXCEPT
     {
         x = direction;
         z = x.cross(up);
@@ -37,7 +37,7 @@ struct ONB
         y = z.cross(x);
     }
 
-    NODISCARD Eigen::Vector3d Transform(const Eigen::Vector3d& vec) const NOEXCEPT
+    NODISCARD Vector3r Transform(const Vector3r& vec) const NOEXCEPT
     {
         return vec.x() * x + vec.y() * y + vec.z() * z;
     }
@@ -18,99 +18,152 @@
 // Ref: https://graphicscodex.com/app/app.html?page=_rn_rayCst
 // Ref: https://raytracing.github.io/books/RayTracingTheNextWeek.html#quadrilaterals/definingthequadrilateral
 
-NODISCARD bool Triangle::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+NODISCARD bool Triangle::Intersect(const Ray &ray, const Interval& interval, Real& t, Vector2r& uv) const NOEXCEPT
 {
-    const Eigen::Vector3d& v1v0 = u;
-    const Eigen::Vector3d& v2v0 = v;
-    const Eigen::Vector3d rov0 = ray.origin - origin;
-    const Eigen::Vector3d n = v1v0.cross(v2v0);
+    const Vector3r& v1v0 = u;
+    const Vector3r& v2v0 = v;
+    const Vector3r rov0 = ray.origin - origin;
+    const Vector3r n = v1v0.cross(v2v0);
 
-    const double rdn = ray.direction.dot(n);
+    const Real rdn = ray.direction.dot(n);
 
     if (FIsZero(rdn)) { return false; }
 
-    const Eigen::Vector3d q = rov0.cross(ray.direction);
-    const double d = 1.0 / rdn;
-    const double uu = d * -q.dot(v2v0);
-    const double vv = d * q.dot(v1v0);
-    const double t = d * -n.dot(rov0);
+    const Vector3r q = rov0.cross(ray.direction);
+    const Real d = (Real)1.0 / rdn;
+    const Real uu = d * -q.dot(v2v0);
+    const Real vv = d * q.dot(v1v0);
+    t = d * -n.dot(rov0);
 
     if (!interval.Contain(t)) { return false; }
 
     if (FIsNegative(uu) || FIsNegative(vv) || Fgt(uu + vv, 1.0)) { return false; }
 
+    uv = Vector2r{uu, vv};
+    return true;
+}
+
+NODISCARD bool Triangle::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+{
+    Real t;
+    Vector2r uv;
+    if (!Intersect(ray, interval, t, uv)) { return false; }
+
     record.t = t;
-    record.hit_point = ray.At(t);
-    record.hit_normal = n.normalized();
-    record.texcoord = Eigen::Vector2d{uu, vv};
-    record.material = material;
+    record.primitive = 0;
+    record.uv = uv;
+    record.hittable = this;
+    record.instance = nullptr;
 
     return true;
 }
 
-NODISCARD bool Quadrangle::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+void Triangle::Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT
+{
+    interaction.hit_point = ray.At(record.t);
+    interaction.hit_normal = u.cross(v).normalized();
+    interaction.texcoord = record.uv;
+    interaction.material = &packed_material;
+}
+
+NODISCARD bool Triangle::Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT
 {
-    if (bounding_box && !bounding_box->Hit(ray, interval))
-    {
-        return false;
-    }
+    Real t;
+    Vector2r uv;
+    return Intersect(ray, interval, t, uv);
+}
 
-    const Eigen::Vector3d n = u.cross(v);
+NODISCARD bool Quadrangle::Intersect(const Ray &ray, const Interval& interval, Real& t) const NOEXCEPT
+{
+    const Vector3r n = u.cross(v);
 
-    const double rdn = ray.direction.dot(n);
+    const Real rdn = ray.direction.dot(n);
 
     if (FIsZero(rdn) || FIsPositive(rdn)) { return false; }
 
-    const double t = (n.dot(origin) - n.dot(ray.origin)) / rdn;
+    t = (n.dot(origin) - n.dot(ray.origin)) / rdn;
 
     if (!interval.Contain(t)) { return false; }
 
-    record.t = t;
-    record.hit_point = ray.At(t);
+    const Vector3r p = ray.At(t) - origin;
+    const Vector3r w = n / n.dot(n);
 
-    const Eigen::Vector3d p = record.hit_point - origin;
-    const Eigen::Vector3d w = n / n.dot(n);
+    const Real alpha = w.dot(p.cross(v));
+    const Real beta = w.dot(u.cross(p));
 
-    const double alpha = w.dot(p.cross(v));
-    const double beta = w.dot(u.cross(p));
+    return !(FIsNegative(alpha) || FIsNegative(beta) || Fgt(alpha, 1.0) || Fgt(beta, 1.0));
+}
 
-    if (FIsNegative(alpha) || FIsNegative(beta) || Fgt(alpha, 1.0) || Fgt(beta, 1.0)) { return false; }
+NODISCARD bool Quadrangle::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+{
+    Real t;
+    if (!Intersect(ray, interval, t)) { return false; }
 
-    record.hit_normal = n.normalized();
-    record.texcoord = Texcoord2D(record.hit_point);
-    record.material = material;
+    // NOTE: Write The Record Only On Success, A Rejected Candidate Must Not Clobber A Closer Hit.
+    record.t = t;
+    record.primitive = 0;
+    record.hittable = this;
+    record.instance = nullptr;
 
     return true;
 }
 
-NODISCARD bool Sphere::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+void Quadrangle::Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT
 {
-    if (bounding_box && !bounding_box->Hit(ray, interval))
-    {
-        return false;
-    }
+    interaction.hit_point = ray.At(record.t);
+    interaction.hit_normal = u.cross(v).normalized();
+    interaction.texcoord = Texcoord2D(interaction.hit_point);
+    interaction.material = &packed_material;
+}
 
-    const Eigen::Vector3d oc = ray.origin - center;
-    const double b = oc.dot(ray.direction);
-    const Eigen::Vector3d qc = oc - b * ray.direction;
-    double h = radius * radius - qc.dot(qc);
+NODISCARD bool Quadrangle::Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT
+{
+    Real t;
+    return Intersect(ray, interval, t);
+}
+
+NODISCARD bool Sphere::Intersect(const Ray &ray, const Interval& interval, Real& t) const NOEXCEPT
+{
+    const Vector3r oc = ray.origin - center;
+    const Real b = oc.dot(ray.direction);
+    const Vector3r qc = oc - b * ray.direction;
+    Real h = radius * radius - qc.dot(qc);
 
     if (FIsNegative(h)) { return false; }
 
     h = std::sqrt(h);
-    const double tmin = - b - h;
-    const double tmax = - b + h;
+    const Real tmin = - b - h;
+    const Real tmax = - b + h;
 
     if (FIsNegative(tmax)) { return false; }
 
-    const double t = FIsNegative(tmin) ? tmax : tmin;
-    if (!interval.Contain(t)) { return false; }
+    t = FIsNegative(tmin) ? tmax : tmin;
+    return interval.Contain(t);
+}
+
+NODISCARD bool Sphere::Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT
+{
+    Real t;
+    if (!Intersect(ray, interval, t)) { return false; }
 
     record.t = t;
-    record.hit_point = ray.At(t);
-    record.hit_normal = (record.hit_point - center).normalized();
-    record.texcoord = Texcoord2D(record.hit_point);
-    record.material = material;
+    record.primitive = 0;
+    record.hittable = this;
+    record.instance = nullptr;
 
     return true;
 }
+
+void Sphere::Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT
+{
+    interaction.hit_point = ray.At(record.t);
+    interaction.hit_normal = (interaction.hit_point - center).normalized();
+    interaction.texcoord = Texcoord2D(interaction.hit_point);
+    interaction.material = &packed_material;
+}
+
+NODISCARD bool Sphere::Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT
+{
+    Real t;
+    return Intersect(ray, interval, t);
+}
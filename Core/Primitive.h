@@ -15,6 +15,7 @@
 
 #include <Core/Common.h>
 #include <Core/Hittable.h>
+#include <Core/Material.h>
 
 struct Primitive : Hittable
 {
@@ -22,12 +23,10 @@ struct Primitive : Hittable
     { return HITTABLE_KIND_PRIMITIVE_START < ptr->Kind() && ptr->Kind() < HITTABLE_KIND_PRIMITIVE_END; }
 
 protected:
-    Ref<BoundingBox> bounding_box;
-    NODISCARD const Ref<BoundingBox>& GetBoundingBox() const NOEXCEPT OVERRIDE { return bounding_box; }
-    NODISCARD explicit Primitive(HittableKind hittable_type) NOEXCEPT : Hittable(hittable_type), bounding_box(nullptr) {}
+    NODISCARD explicit Primitive(HittableKind hittable_type) NOEXCEPT : Hittable(hittable_type) {}
 
     // Interface.
-    NODISCARD virtual Ref<BoundingBox> CreateBoundingBox() const NOEXCEPT = 0;
+    NODISCARD virtual AABB CreateBoundingBox() const NOEXCEPT = 0;
 };
 
 // struct Plane final : Primitive3D
@@ -35,9 +34,9 @@ protected:
 //     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_TYPE_PLANE;}
 //
 //     Ref<Material> material;
-//     Eigen::Vector4d plane; // Ax + By + Cz + D = 0
+//     Vector4r plane; // Ax + By + Cz + D = 0
 //
-//     NODISCARD Plane(const Ref<Material>& material, const Eigen::Vector3d& center, const Eigen::Vector3d& normal) NOEXCEPT
+//     NODISCARD Plane(const Ref<Material>& material, const Vector3r& center, const Vector3r& normal) NOEXCEPT
 //     : Primitive3D(HITTABLE_TYPE_PLANE, MakeRef<AABB3D>(AABB3D::UNIVERSE)), material(material), plane(normal)
 //     {
 //         plane.w() = -normal.dot(center);
@@ -49,7 +48,7 @@ protected:
 //         aabb = AABB3D::UNIVERSE;
 //     }
 //
-//     NODISCARD Eigen::Vector2d UV(const Eigen::Vector3d& hit_point) const NOEXCEPT
+//     NODISCARD Vector2r UV(const Vector3r& hit_point) const NOEXCEPT
 //     {
 //
 //     }
@@ -62,11 +61,11 @@ protected:
 //     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_TYPE_DISK;}
 //
 //     Ref<Material> material;
-//     Eigen::Vector3d center;
-//     Eigen::Vector3d normal;
-//     double radius;
+//     Vector3r center;
+//     Vector3r normal;
+//     Real radius;
 //
-//     NODISCARD Disk(const Ref<Material>& material, Eigen::Vector3d center, Eigen::Vector3d normal, const double radius) NOEXCEPT
+//     NODISCARD Disk(const Ref<Material>& material, Vector3r center, Vector3r normal, const Real radius) NOEXCEPT
 //     : Primitive(HITTABLE_TYPE_DISK), material(material), center(std::move(center)), normal(std::move(normal)), radius(radius)
 //     {
 //         InitializeAABB();
@@ -74,9 +73,9 @@ protected:
 //
 //     void InitializeAABB() NOEXCEPT OVERRIDE
 //     {
-//         const double delta_x = radius * normal.cross(Eigen::Vector3d(1.0, 0.0, 0.0)).norm();
-//         const double delta_y = radius * normal.cross(Eigen::Vector3d(0.0, 1.0, 0.0)).norm();
-//         const double delta_z = radius * normal.cross(Eigen::Vector3d(0.0, 0.0, 1.0)).norm();
+//         const Real delta_x = radius * normal.cross(Vector3r(1.0, 0.0, 0.0)).norm();
+//         const Real delta_y = radius * normal.cross(Vector3r(0.0, 1.0, 0.0)).norm();
+//         const Real delta_z = radius * normal.cross(Vector3r(0.0, 0.0, 1.0)).norm();
 //         aabb.vmin.x() = center.x() - delta_x;
 //         aabb.vmax.x() = center.x() + delta_x;
 //         aabb.vmin.y() = center.y() - delta_y;
@@ -85,7 +84,7 @@ protected:
 //         aabb.vmax.z() = center.z() + delta_z;
 //     }
 //
-//     NODISCARD Eigen::Vector2d UV(const Eigen::Vector3d& hit_point) const NOEXCEPT
+//     NODISCARD Vector2r UV(const Vector3r& hit_point) const NOEXCEPT
 //     {
 //
 //     }
@@ -98,9 +97,9 @@ protected:
 //     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_TYPE_TRIANGLE;}
 //
 //     Ref<Material> material;
-//     Eigen::Vector3d v0, v1, v2;
+//     Vector3r v0, v1, v2;
 //
-//     NODISCARD Triangle(const Ref<Material>& material, Eigen::Vector3d v0, Eigen::Vector3d v1, Eigen::Vector3d v2) NOEXCEPT
+//     NODISCARD Triangle(const Ref<Material>& material, Vector3r v0, Vector3r v1, Vector3r v2) NOEXCEPT
 //     : Primitive(HITTABLE_TYPE_TRIANGLE), material(material), v0(std::move(v0)), v1(std::move(v1)), v2(std::move(v2))
 //     {
 //         InitializeAABB();
@@ -112,7 +111,7 @@ protected:
 //         aabb.vmax = v0.array().max(v1.array().max(v2.array()));
 //     }
 //
-//     NODISCARD Eigen::Vector2d UV(const Eigen::Vector3d& hit_point) const NOEXCEPT
+//     NODISCARD Vector2r UV(const Vector3r& hit_point) const NOEXCEPT
 //     {
 //
 //     }
@@ -125,48 +124,40 @@ struct Triangle final : Primitive
     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_KIND_TRIANGLE;}
 
     Ref<Material> material;
-    Eigen::Vector3d origin;
-    Eigen::Vector3d u, v;
+    PackedMaterial packed_material; // Packed On Construction.
+    Vector3r origin;
+    Vector3r u, v;
 
-    NODISCARD Triangle(const Ref<Material>& material, Eigen::Vector3d origin, Eigen::Vector3d u, Eigen::Vector3d v) NOEXCEPT
-    : Primitive(HITTABLE_KIND_QUADRANGLE), material(material), origin(std::move(origin)), u(std::move(u)), v(std::move(v))
+    NODISCARD Triangle(const Ref<Material>& material, Vector3r origin, Vector3r u, Vector3r v) NOEXCEPT
+    : Primitive(HITTABLE_KIND_TRIANGLE), material(material), packed_material(PackedMaterial::From(material.get())), origin(std::move(origin)), u(std::move(u)), v(std::move(v))
     {
-        // NOTE: No Need.
-        // bounding_box = CreateBoundingBox();
+        bounding_box = CreateBoundingBox();
     }
 
-    NODISCARD Ref<BoundingBox> CreateBoundingBox() const NOEXCEPT OVERRIDE
+    NODISCARD AABB CreateBoundingBox() const NOEXCEPT OVERRIDE
     {
-        Eigen::Vector3d p0 = origin + u;
-        Eigen::Vector3d p1 = origin + v;
-        return MakeRef<AABB>(
-            Eigen::Vector3d {
-                std::min(std::min(origin.x(), origin.y()), origin.z()),
-                std::min(std::min(p0.x(), p0.y()), p0.z()),
-                std::min(std::min(p1.x(), p1.y()), p1.z())
-            },
-            Eigen::Vector3d {
-                std::max(std::max(origin.x(), origin.y()), origin.z()),
-                std::max(std::max(p0.x(), p0.y()), p0.z()),
-                std::max(std::max(p1.x(), p1.y()), p1.z())
-            }
-        );
+        const Vector3r p0 = origin + u;
+        const Vector3r p1 = origin + v;
+        return { origin.cwiseMin(p0).cwiseMin(p1), origin.cwiseMax(p0).cwiseMax(p1) };
     }
 
-    NODISCARD Eigen::Vector2d Texcoord2D(const Eigen::Vector3d& hit_point) const NOEXCEPT
+    NODISCARD Vector2r Texcoord2D(const Vector3r& hit_point) const NOEXCEPT
     {
-        const Eigen::Vector3d p = hit_point - origin;
-        const double u_length = std::sqrt(u.squaredNorm());
-        const double v_length = std::sqrt(v.squaredNorm());
-        const double a = p.dot(u) / u_length;
-        const double b = p.dot(v) / v_length;
-        const double cos_theta = u.dot(v) / (u_length * v_length);
-        const double aa = (a + b) / (1 + cos_theta);
-        const double bb = (a - b) / (1 - cos_theta);
-        return { (aa + bb) / 2.0, (aa - bb) / 2.0 };
+        const Vector3r p = hit_point - origin;
+        const Real u_length = std::sqrt(u.squaredNorm());
+        const Real v_length = std::sqrt(v.squaredNorm());
+        const Real a = p.dot(u) / u_length;
+        const Real b = p.dot(v) / v_length;
+        const Real cos_theta = u.dot(v) / (u_length * v_length);
+        const Real aa = (a + b) / (1 + cos_theta);
+        const Real bb = (a - b) / (1 - cos_theta);
+        return { (aa + bb) / (Real)2.0, (aa - bb) / (Real)2.0 };
     }
 
+    NODISCARD bool Intersect(const Ray &ray, const Interval& interval, Real& t, Vector2r& uv) const NOEXCEPT;
     NODISCARD bool Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT OVERRIDE;
+    NODISCARD bool Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT OVERRIDE;
+    void Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT OVERRIDE;
 };
 
 struct Quadrangle final : Primitive
@@ -174,38 +165,41 @@ struct Quadrangle final : Primitive
     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_KIND_QUADRANGLE;}
 
     Ref<Material> material;
-    Eigen::Vector3d origin;
-    Eigen::Vector3d u, v;
+    PackedMaterial packed_material; // Packed On Construction.
+    Vector3r origin;
+    Vector3r u, v;
 
-    NODISCARD Quadrangle(const Ref<Material>& material, Eigen::Vector3d origin, Eigen::Vector3d u, Eigen::Vector3d v) NOEXCEPT
-    : Primitive(HITTABLE_KIND_QUADRANGLE), material(material), origin(std::move(origin)), u(std::move(u)), v(std::move(v))
+    NODISCARD Quadrangle(const Ref<Material>& material, Vector3r origin, Vector3r u, Vector3r v) NOEXCEPT
+    : Primitive(HITTABLE_KIND_QUADRANGLE), material(material), packed_material(PackedMaterial::From(material.get())), origin(std::move(origin)), u(std::move(u)), v(std::move(v))
     {
-        // NOTE: No Need.
-        // bounding_box = CreateBoundingBox();
+        bounding_box = CreateBoundingBox();
     }
 
-    NODISCARD Ref<BoundingBox> CreateBoundingBox() const NOEXCEPT OVERRIDE
+    NODISCARD AABB CreateBoundingBox() const NOEXCEPT OVERRIDE
     {
-        return MakeRef<AABB>(
+        return {
             AABB(origin, origin + u),
             AABB(origin + v, origin + u + v)
-        );
+        };
     }
 
-    NODISCARD Eigen::Vector2d Texcoord2D(const Eigen::Vector3d& hit_point) const NOEXCEPT
+    NODISCARD Vector2r Texcoord2D(const Vector3r& hit_point) const NOEXCEPT
     {
-        const Eigen::Vector3d p = hit_point - origin;
-        const double u_length = std::sqrt(u.squaredNorm());
-        const double v_length = std::sqrt(v.squaredNorm());
-        const double a = p.dot(u) / u_length;
-        const double b = p.dot(v) / v_length;
-        const double cos_theta = u.dot(v) / (u_length * v_length);
-        const double aa = (a + b) / (1 + cos_theta);
-        const double bb = (a - b) / (1 - cos_theta);
-        return { (aa + bb) / 2.0, (aa - bb) / 2.0 };
+        const Vector3r p = hit_point - origin;
+        const Real u_length = std::sqrt(u.squaredNorm());
+        const Real v_length = std::sqrt(v.squaredNorm());
+        const Real a = p.dot(u) / u_length;
+        const Real b = p.dot(v) / v_length;
+        const Real cos_theta = u.dot(v) / (u_length * v_length);
+        const Real aa = (a + b) / (1 + cos_theta);
+        const Real bb = (a - b) / (1 - cos_theta);
+        return { (aa + bb) / (Real)2.0, (aa - bb) / (Real)2.0 };
     }
 
+    NODISCARD bool Intersect(const Ray &ray, const Interval& interval, Real& t) const NOEXCEPT;
     NODISCARD bool Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT OVERRIDE;
+    NODISCARD bool Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT OVERRIDE;
+    void Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT OVERRIDE;
 };
 
 struct Sphere final : Primitive
@@ -213,30 +207,33 @@ struct Sphere final : Primitive
     NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Hittable* ptr) NOEXCEPT {return ptr->Kind() == HITTABLE_KIND_SPHERE;}
 
     Ref<Material> material;
-    Eigen::Vector3d center;
-    double radius;
+    PackedMaterial packed_material; // Packed On Construction.
+    Vector3r center;
+    Real radius;
 
-    NODISCARD Sphere(const Ref<Material>& material, Eigen::Vector3d center, const double radius) NOEXCEPT
-    : Primitive(HITTABLE_KIND_SPHERE), material(material), center(std::move(center)), radius(radius)
+    NODISCARD Sphere(const Ref<Material>& material, Vector3r center, const Real radius) NOEXCEPT
+    : Primitive(HITTABLE_KIND_SPHERE), material(material), packed_material(PackedMaterial::From(material.get())), center(std::move(center)), radius(radius)
     {
-        // NOTE: No Need.
-        // bounding_box = CreateBoundingBox();
+        bounding_box = CreateBoundingBox();
     }
 
-    NODISCARD Ref<BoundingBox> CreateBoundingBox() const NOEXCEPT OVERRIDE
+    NODISCARD AABB CreateBoundingBox() const NOEXCEPT OVERRIDE
     {
-        return MakeRef<AABB>(center - Eigen::Vector3d{radius, radius, radius}, center + Eigen::Vector3d{radius, radius, radius});
+        return { center - Vector3r{radius, radius, radius}, center + Vector3r{radius, radius, radius} };
     }
 
-    NODISCARD Eigen::Vector2d Texcoord2D(const Eigen::Vector3d& hit_point) const NOEXCEPT
+    NODISCARD Vector2r Texcoord2D(const Vector3r& hit_point) const NOEXCEPT
     {
-        const Eigen::Vector3d p = (hit_point - center).normalized();
-        const double theta = std::acos(p.y());
-        const double phi = std::atan2(p.z(), p.x()) + PI;
-        return { phi / (2.0 * PI), theta / PI };
+        const Vector3r p = (hit_point - center).normalized();
+        const Real theta = std::acos(p.y());
+        const Real phi = std::atan2(p.z(), p.x()) + PI;
+        return { phi / ((Real)2.0 * PI), theta / PI };
     }
 
+    NODISCARD bool Intersect(const Ray &ray, const Interval& interval, Real& t) const NOEXCEPT;
     NODISCARD bool Hit(const Ray &ray, const Interval& interval, HitRecord &record) const NOEXCEPT OVERRIDE;
+    NODISCARD bool Occluded(const Ray &ray, const Interval& interval) const NOEXCEPT OVERRIDE;
+    void Interact(const Ray& ray, const HitRecord& record, SurfaceInteraction& interaction) const NOEXCEPT OVERRIDE;
 };
 
 #endif //PRIMITIVE_H
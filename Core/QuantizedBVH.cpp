@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file           : QuantizedBVH.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-30
+  ******************************************************************************
+  */
+
+
+
+#include <Core/QuantizedBVH.h>
+#include <Core/Parallel.h>
+
+namespace
+{
+
+template<int WIDTH, typename T>
+QuantizedBVHNode<WIDTH, T> Quantize(const WideBVHNode<WIDTH>& wide) NOEXCEPT
+{
+    CONSTEXPR T Q_MAX = std::numeric_limits<T>::max();
+
+    QuantizedBVHNode<WIDTH, T> node = {};
+    for (int lane = 0; lane < WIDTH; ++lane)
+    {
+        node.child[lane] = wide.child[lane];
+        node.count[lane] = wide.count[lane];
+        // Only The Root Has Index Zero, So child == 0 && count == 0 Marks An Unused Slot.
+        if (wide.count[lane] != 0 || wide.child[lane] != 0) { node.valid |= (uint8_t)(1u << lane); }
+    }
+
+    for (int a = 0; a < 3; ++a)
+    {
+        float lo = std::numeric_limits<float>::infinity();
+        float hi = -std::numeric_limits<float>::infinity();
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            if (!(node.valid >> lane & 1u)) { continue; }
+            lo = std::min(lo, wide.bmin[a][lane]);
+            hi = std::max(hi, wide.bmax[a][lane]);
+        }
+        ASSERT(lo <= hi);
+
+        // Smallest Power Of Two Step With origin + Q_MAX * step >= hi.
+        node.origin[a] = lo;
+        int e;
+        std::frexp(((double)hi - (double)lo) / (double)Q_MAX, &e);
+        e = std::clamp(e, -126, 127);
+        node.exponent[a] = (int8_t)e;
+        while (node.Dequantize(a, Q_MAX) < (double)hi)
+        {
+            ASSERT(node.exponent[a] < 127);
+            ++node.exponent[a];
+        }
+        const double scale = QuantizedBVHNode<WIDTH, T>::Scale(node.exponent[a]);
+
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            if (!(node.valid >> lane & 1u))
+            {
+                node.qmin[a][lane] = Q_MAX;
+                node.qmax[a][lane] = 0;
+                continue;
+            }
+
+            // Estimate, Then Step Until The Dequantized Box Contains The Float Box.
+            const double bmin = wide.bmin[a][lane];
+            const double bmax = wide.bmax[a][lane];
+            T qmin = (T)std::clamp(std::floor((bmin - (double)lo) / scale), 0.0, (double)Q_MAX);
+            T qmax = (T)std::clamp(std::ceil((bmax - (double)lo) / scale), 0.0, (double)Q_MAX);
+            while (qmin > 0 && node.Dequantize(a, qmin) > bmin) { --qmin; }
+            while (qmax < Q_MAX && node.Dequantize(a, qmax) < bmax) { ++qmax; }
+            ASSERT(node.Dequantize(a, qmin) <= bmin && node.Dequantize(a, qmax) >= bmax);
+            node.qmin[a][lane] = qmin;
+            node.qmax[a][lane] = qmax;
+        }
+    }
+
+    return node;
+}
+
+}
+
+template<int WIDTH, typename T>
+NODISCARD QuantizedBVH<WIDTH, T> QuantizedBVH<WIDTH, T>::From(const WideBVH<WIDTH>& wide) NOEXCEPT
+{
+    std::vector<QuantizedBVHNode<WIDTH, T>> t_nodes(wide.nodes.size());
+    Parallel::For(0, t_nodes.size(), THREAD_POOL.ThreadNumber(),
+        [&wide, &t_nodes](size_t thread_begin, size_t thread_end)
+        {
+            for (size_t i = thread_begin; i < thread_end; ++i)
+            {
+                t_nodes[i] = Quantize<WIDTH, T>(wide.nodes[i]);
+            }
+        }
+    );
+
+    QuantizedBVH bvh;
+    bvh.nodes = std::move(t_nodes);
+    return bvh;
+}
+
+template<int WIDTH, typename T>
+NODISCARD WideBVH<WIDTH> QuantizedBVH<WIDTH, T>::ToWide() const NOEXCEPT
+{
+    std::vector<WideBVHNode<WIDTH>> t_nodes(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        const QuantizedBVHNode<WIDTH, T>& node = nodes[i];
+        WideBVHNode<WIDTH>& wide = t_nodes[i];
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            const bool valid = node.valid >> lane & 1u;
+            for (int a = 0; a < 3; ++a)
+            {
+                wide.bmin[a][lane] = valid ? FRoundDown(node.Dequantize(a, node.qmin[a][lane])) : std::numeric_limits<float>::infinity();
+                wide.bmax[a][lane] = valid ? FRoundUp(node.Dequantize(a, node.qmax[a][lane])) : -std::numeric_limits<float>::infinity();
+            }
+            wide.child[lane] = node.child[lane];
+            wide.count[lane] = node.count[lane];
+        }
+    }
+
+    WideBVH<WIDTH> bvh;
+    bvh.nodes = std::move(t_nodes);
+    return bvh;
+}
+
+template<int WIDTH, typename T>
+void QuantizedBVH<WIDTH, T>::Refit(const std::vector<BVHBuilder::Primitive>& primitives) NOEXCEPT
+{
+    WideBVH<WIDTH> wide = ToWide();
+    wide.Refit(primitives);
+    *this = From(wide);
+}
+
+template<int WIDTH, typename T>
+NODISCARD double QuantizedBVH<WIDTH, T>::Cost(const BVHConfig& config) const NOEXCEPT
+{
+    // Quantization Only Grows Boxes, So This Is The Cost Traversal Actually Pays.
+    return ToWide().Cost(config);
+}
+
+template struct QuantizedBVH<8, uint8_t>;
+template struct QuantizedBVH<8, uint16_t>;
@@ -0,0 +1,186 @@
+/**
+  ******************************************************************************
+  * @file           : QuantizedBVH.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-30
+  ******************************************************************************
+  */
+
+
+
+#ifndef QUANTIZED_BVH_H
+#define QUANTIZED_BVH_H
+
+#include <Core/Common.h>
+#include <Core/Ray.h>
+#include <Core/Interval.h>
+#include <Core/BVHBuilder.h>
+#include <Core/Buffer.h>
+#include <Core/WideBVH.h>
+
+#include <cstring>
+
+// Wide Node With Child Bounds Stored As 8 Or 16 Bit Offsets From The Node Origin. Ref: https://research.nvidia.com/publication/2017-07_efficient-incoherent-ray-traversal-gpus-through-compressed-wide-bvhs
+// Along Axis a A Child Spans [origin[a] + qmin[a] * 2^exponent[a], origin[a] + qmax[a] * 2^exponent[a]], Rounded Outwards.
+// Unused Slots Are Cleared In valid. Their Inverted Bounds Alone Do Not Reliably Miss After Rounding.
+template<int WIDTH, typename T>
+struct alignas(16) QuantizedBVHNode
+{
+    static_assert(WIDTH == 4 || WIDTH == 8);
+    static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t>);
+
+    float origin[3];
+    int8_t exponent[3];
+    uint8_t valid;         // Bit Mask Of Used Slots.
+    T qmin[3][WIDTH];
+    T qmax[3][WIDTH];
+    uint32_t child[WIDTH]; // Interior Child: Node Index. Leaf Child: First Primitive.
+    uint16_t count[WIDTH]; // Leaf Child: Number Of Primitives. Zero For Interior Child.
+
+    // q * 2^e Is Exact, So The Sum Rounds Once And Build And Traversal Agree With Or Without FMA.
+    NODISCARD FORCE_INLINE static double Scale(const int8_t e) NOEXCEPT
+    {
+        return std::bit_cast<double>((uint64_t)(1023 + e) << 52);
+    }
+
+    NODISCARD FORCE_INLINE double Dequantize(const int a, const T q) const NOEXCEPT
+    {
+        return (double)origin[a] + (double)q * Scale(exponent[a]);
+    }
+};
+
+static_assert(sizeof(QuantizedBVHNode<8, uint8_t>) == 112 && sizeof(WideBVHNode<8>) == 256);
+
+template<int WIDTH, typename T>
+struct QuantizedBVH
+{
+    Buffer<QuantizedBVHNode<WIDTH, T>> nodes;
+
+    // Same Topology As The Wide Tree, Each Node Is Quantized Against The Union Of Its Children.
+    NODISCARD static QuantizedBVH From(const WideBVH<WIDTH>& wide) NOEXCEPT;
+
+    // Dequantized Bounds, Still Conservative. Used To Refit Through WideBVH::Refit.
+    NODISCARD WideBVH<WIDTH> ToWide() const NOEXCEPT;
+
+    // Recomputes Full Precision Bounds Bottom Up, Then Quantizes Again.
+    void Refit(const std::vector<BVHBuilder::Primitive>& primitives) NOEXCEPT;
+
+    NODISCARD double Cost(const BVHConfig& config) const NOEXCEPT;
+
+    // Writes The Entry Distance Of Every Child, Returns A Bit Mask Of The Children Hit.
+    NODISCARD FORCE_INLINE static uint32_t Hit(const QuantizedBVHNode<WIDTH, T>& node, const Ray& ray, const Interval& interval, Real t_entry[WIDTH]) NOEXCEPT
+    {
+        uint32_t mask = 0;
+        #if defined(__AVX__) && defined(REAL_FLOAT)
+        // Dequantized In Float. q * 2^e Is Still Exact And Rounding The Sum Cannot Cross The Float Child Bounds It Was Built From.
+        for (int lane = 0; lane < WIDTH; lane += 4)
+        {
+            __m128 t0 = _mm_set1_ps(interval.imin);
+            __m128 t1 = _mm_set1_ps(interval.imax);
+            for (int a = 0; a < 3; ++a)
+            {
+                const __m128 base = _mm_set1_ps(node.origin[a]);
+                const __m128 scale = _mm_set1_ps((float)QuantizedBVHNode<WIDTH, T>::Scale(node.exponent[a]));
+                const __m128 lo = _mm_add_ps(base, _mm_mul_ps(Load(node.qmin[a] + lane), scale));
+                const __m128 hi = _mm_add_ps(base, _mm_mul_ps(Load(node.qmax[a] + lane), scale));
+                const __m128 o = _mm_set1_ps(ray.origin[a]);
+                const __m128 inv = _mm_set1_ps(ray.inv_direction[a]);
+                const __m128 t_near = _mm_mul_ps(_mm_sub_ps(ray.sign[a] ? hi : lo, o), inv);
+                const __m128 t_far = _mm_mul_ps(_mm_sub_ps(ray.sign[a] ? lo : hi, o), inv);
+                t0 = _mm_max_ps(t_near, t0);
+                t1 = _mm_min_ps(t_far, t1);
+            }
+            _mm_storeu_ps(t_entry + lane, t0);
+            mask |= (uint32_t)_mm_movemask_ps(_mm_cmp_ps(t0, t1, _CMP_LE_OQ)) << lane;
+        }
+        #elif defined(__AVX__)
+        // Dequantized In Double Like The Scalar Path, Results Match It Exactly.
+        for (int lane = 0; lane < WIDTH; lane += 4)
+        {
+            __m256d t0 = _mm256_set1_pd(interval.imin);
+            __m256d t1 = _mm256_set1_pd(interval.imax);
+            for (int a = 0; a < 3; ++a)
+            {
+                const __m256d base = _mm256_set1_pd((double)node.origin[a]);
+                const __m256d scale = _mm256_set1_pd(QuantizedBVHNode<WIDTH, T>::Scale(node.exponent[a]));
+                const __m256d lo = _mm256_add_pd(base, _mm256_mul_pd(Load(node.qmin[a] + lane), scale));
+                const __m256d hi = _mm256_add_pd(base, _mm256_mul_pd(Load(node.qmax[a] + lane), scale));
+                const __m256d o = _mm256_set1_pd(ray.origin[a]);
+                const __m256d inv = _mm256_set1_pd(ray.inv_direction[a]);
+                const __m256d t_near = _mm256_mul_pd(_mm256_sub_pd(ray.sign[a] ? hi : lo, o), inv);
+                const __m256d t_far = _mm256_mul_pd(_mm256_sub_pd(ray.sign[a] ? lo : hi, o), inv);
+                t0 = _mm256_max_pd(t_near, t0);
+                t1 = _mm256_min_pd(t_far, t1);
+            }
+            _mm256_storeu_pd(t_entry + lane, t0);
+            mask |= (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(t0, t1, _CMP_LE_OQ)) << lane;
+        }
+        #else
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            Real t0 = interval.imin, t1 = interval.imax;
+            for (int a = 0; a < 3; ++a)
+            {
+                const Real lo = (Real)node.Dequantize(a, node.qmin[a][lane]);
+                const Real hi = (Real)node.Dequantize(a, node.qmax[a][lane]);
+                const Real t_near = ((ray.sign[a] ? hi : lo) - ray.origin[a]) * ray.inv_direction[a];
+                const Real t_far = ((ray.sign[a] ? lo : hi) - ray.origin[a]) * ray.inv_direction[a];
+                t0 = std::max(t0, t_near);
+                t1 = std::min(t1, t_far);
+            }
+            t_entry[lane] = t0;
+            mask |= (uint32_t)(t0 <= t1) << lane;
+        }
+        #endif
+        return mask & node.valid;
+    }
+
+    #if defined(__AVX__) && defined(REAL_FLOAT)
+    // Four Consecutive Quantized Values Widened To Float.
+    NODISCARD FORCE_INLINE static __m128 Load(const T* q) NOEXCEPT
+    {
+        if CONSTEXPR (std::is_same_v<T, uint8_t>)
+        {
+            int32_t packed;
+            std::memcpy(&packed, q, sizeof(packed));
+            return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+        }
+        else
+        {
+            return _mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)q)));
+        }
+    }
+    #elif defined(__AVX__)
+    // Four Consecutive Quantized Values Widened To Double.
+    NODISCARD FORCE_INLINE static __m256d Load(const T* q) NOEXCEPT
+    {
+        if CONSTEXPR (std::is_same_v<T, uint8_t>)
+        {
+            int32_t packed;
+            std::memcpy(&packed, q, sizeof(packed));
+            return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed)));
+        }
+        else
+        {
+            return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)q)));
+        }
+    }
+    #endif
+
+    // HitPrimitive: bool(Eigen::Index index, Interval& interval). Shrinks interval.imax On A Closer Hit.
+    // ANY_HIT: Stop At The First Primitive Hit, For Occlusion Queries.
+    template<bool ANY_HIT = false, typename HitPrimitive>
+    NODISCARD FORCE_INLINE bool Traverse(const Ray& ray, const Interval& interval, HitPrimitive&& hit_primitive) const NOEXCEPT
+    {
+        return WideTraverse<WIDTH, ANY_HIT>(nodes, ray, interval,
+            [](const QuantizedBVHNode<WIDTH, T>& node, const Ray& ray, const Interval& t_interval, Real t_entry[WIDTH]) -> uint32_t
+            {
+                return Hit(node, ray, t_interval, t_entry);
+            },
+            std::forward<HitPrimitive>(hit_primitive));
+    }
+};
+
+#endif //QUANTIZED_BVH_H
@@ -17,16 +17,25 @@
 
 struct Hittable;
 
+// Slab Tests Only Read inv_direction And sign, Which Are Computed Once Here. Do Not Modify direction Afterwards.
 struct Ray
 {
-    Eigen::Vector3d origin;
-    Eigen::Vector3d direction;
+    Vector3r origin;
+    Vector3r direction;
+    Vector3r inv_direction; // Zero Components Give Signed INF, See AABB::Hit.
+    int sign[3];                   // Axis Direction Is Negative, Also For -0.0.
 
-    NODISCARD Ray(Eigen::Vector3d origin, Eigen::Vector3d direction) NOEXCEPT
+    NODISCARD Ray(Vector3r origin, Vector3r direction) NOEXCEPT
     : origin(std::move(origin)), direction(std::move(direction))
-    {}
-
-    NODISCARD Eigen::Vector3d At(const double t) const NOEXCEPT { return origin + t * direction; }
+    {
+        inv_direction = this->direction.cwiseInverse();
+        for (int a = 0; a < 3; ++a)
+        {
+            sign[a] = std::signbit(this->direction[a]);
+        }
+    }
+
+    NODISCARD Vector3r At(const Real t) const NOEXCEPT { return origin + t * direction; }
 };
 
 #endif //RAY_H
@@ -12,106 +12,285 @@
 
 #include <Core/Renderer.h>
 #include <Core/Parallel.h>
+#include <Core/Debug.h>
 #include <Core/Image.h>
 #include <Core/Camera.h>
 #include <Core/Hittable.h>
 #include <Core/Material.h>
 #include <Core/Sampler.h>
+#include <Core/Light.h>
 
-NODISCARD Eigen::Vector3d Renderer::RayCast(const Ray& ray, const Ref<Hittable>& hittable, const std::vector<Ref<Hittable>>& lights, const Eigen::Index bounce, const double stop_prob) NOEXCEPT // NOLINT(*-no-recursion)
+namespace
 {
-    HitRecord record;
 
-    if (!hittable->Hit(ray, Interval{ EPS, INF }, record))
+// Bound On The Self Intersection Distance Of A Ray Leaving point, Which Is Only Known Up To Rounding.
+NODISCARD FORCE_INLINE Real SpawnEpsilon(const Vector3r& point) NOEXCEPT
+{
+    CONSTEXPR Real relative = (Real)1024.0 * std::numeric_limits<Real>::epsilon();
+    return relative * ((Real)1.0 + point.cwiseAbs().maxCoeff());
+}
+
+// Renders In Rounds Of One Stratified Pass Per Pixel, Only Over Tiles Still Holding A Pixel Whose Relative Standard Error
+// Exceeds config.target_error, Until None Do Or Pixels Reach config.SPP. Tiles Are Also The Unit Of Parallel Work.
+void RenderAdaptive(const Camera& camera, const Ref<Hittable>& scene, const LightList& lights, const RenderConfig& config, Image& film) NOEXCEPT
+{
+    CONSTEXPR Eigen::Index tile_size = 8;
+    CONSTEXPR Eigen::Index min_rounds = 2;      // Variance Estimated From Fewer Samples Is Too Unreliable To Stop On.
+    CONSTEXPR double error_floor = 1.0 / 256.0; // Error Is Relative To At Least This Brightness, Or Near Black Pixels Never Stop.
+
+    struct PixelStatistics
+    {
+        Vector3r sum;
+        double luminance_sum;
+        double luminance_sum2;
+        Eigen::Index count;
+    };
+
+    const Eigen::Index round_jitter = std::clamp((Eigen::Index)SSqrt((Real)config.SPP), (Eigen::Index)1, (Eigen::Index)4);
+    const Eigen::Index round_spp = round_jitter * round_jitter;
+    const Eigen::Index max_rounds = std::max(config.SPP / round_spp, (Eigen::Index)1);
+
+    const Eigen::Index height = film.Height();
+    const Eigen::Index width = film.Width();
+    const Eigen::Index tile_rows = (height + tile_size - 1) / tile_size;
+    const Eigen::Index tile_cols = (width + tile_size - 1) / tile_size;
+
+    std::vector<PixelStatistics> statistics(height * width, PixelStatistics{ Vector3r{ 0.0, 0.0, 0.0 }, 0.0, 0.0, 0 });
+    std::vector<Eigen::Index> active(tile_rows * tile_cols);
+    std::iota(active.begin(), active.end(), (Eigen::Index)0);
+
+    auto dist = RNG::UniformDist<unsigned int>(0, std::numeric_limits<unsigned int>::max());
+    #ifdef NDEBUG
+    std::vector<std::future<bool>> futures;
+    #endif
+
+    const auto st = Debug::Now();
+
+    for (Eigen::Index round = 0; round < max_rounds && !active.empty(); ++round)
     {
-        return Eigen::Vector3d{ 0.0, 0.0, 0.0 };
+        // true When Every Pixel Of tile Has Converged.
+        const auto render_tile = [&camera, &scene, &lights, &config, &statistics, round, round_jitter, round_spp, height, width, tile_cols](const Eigen::Index tile, const unsigned int seed) -> bool
+        {
+            RNG::Seed(seed);
+            const Eigen::Index row_begin = tile / tile_cols * tile_size;
+            const Eigen::Index col_begin = tile % tile_cols * tile_size;
+            bool converged = round + 1 >= min_rounds;
+
+            for (Eigen::Index row = row_begin; row < std::min(row_begin + tile_size, height); ++row)
+            {
+                for (Eigen::Index col = col_begin; col < std::min(col_begin + tile_size, width); ++col)
+                {
+                    PixelStatistics& pixel = statistics[row * width + col];
+                    for (Eigen::Index jitter_row = 0; jitter_row < round_jitter; ++jitter_row)
+                    {
+                        for (Eigen::Index jitter_col = 0; jitter_col < round_jitter; ++jitter_col)
+                        {
+                            const Vector3r color = Renderer::RayCast(camera.SampleRay(row, col, round_jitter, jitter_row, jitter_col), scene, lights, config.stop_prob);
+                            const double luminance = (double)color.sum() / 3.0;
+                            pixel.sum += color;
+                            pixel.luminance_sum += luminance;
+                            pixel.luminance_sum2 += luminance * luminance;
+                        }
+                    }
+                    pixel.count += round_spp;
+
+                    // Treats The Stratified Samples As Independent, Which Overestimates The Error. Stops Late, Never Early.
+                    const double n = (double)pixel.count;
+                    const double mean = pixel.luminance_sum / n;
+                    const double variance = std::max(0.0, (pixel.luminance_sum2 - pixel.luminance_sum * mean) / (n - 1.0));
+                    converged = converged && std::sqrt(variance / n) <= (double)config.target_error * (mean > error_floor ? mean : error_floor);
+                }
+            }
+            return converged;
+        };
+
+        std::vector<bool> converged(active.size());
+        #ifdef NDEBUG
+        futures.resize(active.size());
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            futures[i] = THREAD_POOL.Submit(render_tile, active[i], RNG::Rand(dist));
+        }
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            converged[i] = futures[i].get();
+        }
+        #else
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            converged[i] = render_tile(active[i], RNG::Rand(dist));
+        }
+        #endif
+
+        std::clog << "\rRound " << round + 1 << '/' << max_rounds << " Active Tiles " << active.size() << '/' << tile_rows * tile_cols << std::string(8, ' ') << std::flush;
+
+        Eigen::Index kept = 0;
+        for (size_t i = 0; i < active.size(); ++i)
+        {
+            if (!converged[i])
+            {
+                active[kept++] = active[i];
+            }
+        }
+        active.resize(kept);
     }
 
-    auto dist = RNG::UniformDist<double>(0.0, 1.0);
-    const Eigen::Vector3d& omega_o = -ray.direction;
-    const Eigen::Vector3d& origin = record.hit_point;
-    const Eigen::Vector3d& normal = record.hit_normal;
-    const Eigen::Vector2d& texcoord = record.texcoord;
-    const Ref<Material>& material = record.material;
+    const auto ed = Debug::Now();
 
-    Eigen::Vector3d Lo = material->Emission(texcoord, normal, omega_o);
+    Eigen::Index samples = 0;
+    for (Eigen::Index i = 0; i < height * width; ++i)
+    {
+        const PixelStatistics& pixel = statistics[i];
+        const Vector3r color = pixel.sum / (Real)pixel.count;
+        Vector4r& t_pixel = film.Data()[i];
+        t_pixel.x() = color.x(), t_pixel.y() = color.y(), t_pixel.z() = color.z(), t_pixel.w() = 1.0;
+        samples += pixel.count;
+    }
 
+    std::clog << "\rProgress 100.00% Complete!" << std::string(24, ' ') << std::endl;
+
+    const double microseconds = (double)std::max<size_t>(Debug::MicroSeconds(ed - st), 1);
+    std::clog << "Average SPP: " << std::fixed << std::setprecision(1) << (double)samples / (double)(height * width) << std::endl;
+    std::clog << "Throughput: " << std::fixed << std::setprecision(3) << (double)samples / microseconds << " MRays/s" << std::endl;
+}
+
+}
+
+NODISCARD Vector3r Renderer::RayCast(const Ray& ray, const Ref<Hittable>& hittable, const LightList& lights, const Real stop_prob) NOEXCEPT
+{
     // NOTE: Emission: [min_bounce = 0] Direct: [min_bounce = 1] Indirect: [min_bounce = 2]
-    CONSTEXPR Eigen::Index min_bounce = 8;
-    if (const double rng = RNG::Rand(dist); bounce < min_bounce || rng >= stop_prob) UNLIKELY
+    CONSTEXPR Eigen::Index min_bounce = 3;
+
+    auto dist = RNG::UniformDist<Real>(0.0, 1.0);
+    Vector3r L = Vector3r{ 0.0, 0.0, 0.0 };
+    Vector3r throughput = Vector3r{ 1.0, 1.0, 1.0 }; // Product Of fr * cos / pdf Along The Path So Far.
+    Ray path_ray = ray;
+    Real path_pdf = (Real)0.0; // BSDF Sampler Density Of path_ray.direction, Unused For The Camera Ray.
+    Vector3r path_normal;      // Normal At path_ray.origin, Unused For The Camera Ray.
+
+    for (Eigen::Index bounce = 0;; ++bounce)
     {
-        Ref<Sampler> sampler = nullptr;
+        HitRecord record;
+
+        if (!hittable->Hit(path_ray, Interval{ bounce == 0 ? EPS : SpawnEpsilon(path_ray.origin), INF }, record))
+        {
+            // The environment Was Also Reachable By The Light Sample At The Previous Vertex.
+            if (!lights.environment.IsEmpty())
+            {
+                const Real weight = bounce == 0 ? (Real)1.0 : PowerHeuristic(path_pdf, lights.EnvironmentPDF(path_ray.direction));
+                L.array() += throughput.array() * lights.environment.Radiance(path_ray.direction).array() * weight;
+            }
+            break;
+        }
+
+        const SurfaceInteraction interaction = record.Interact(path_ray);
 
-        if (DynCast<LambertMaterial>(material.get()))
+        const Vector3r omega_o = -path_ray.direction;
+        const Vector3r& origin = interaction.hit_point;
+        const Vector3r& normal = interaction.hit_normal;
+        const ShadingContext context = interaction.material->Shade(interaction.texcoord);
+
+        // Emitters In lights Were Also Reachable By The Light Sample At The Previous Vertex.
+        if (context.emission.maxCoeff() > (Real)0.0)
         {
-            sampler = MakeRef<CosineHemiSphereSampler>();
+            const int32_t emitter = bounce == 0 ? -1 : lights.Find(record);
+            const Real weight = emitter < 0 ? (Real)1.0 : PowerHeuristic(path_pdf, lights.PDF(path_ray.origin, path_normal, emitter, path_ray.direction, record.t));
+            L.array() += throughput.array() * context.emission.array() * weight;
         }
-        else if (const BlinnPhongMaterial* mat = DynCast<BlinnPhongMaterial>(material.get()); mat != nullptr)
+
+        // Russian Roulette Driven By Throughput, So Dim Paths End Early. stop_prob Keeps Bright Paths From Running Forever.
+        if (bounce >= min_bounce)
         {
-            const Ref<Sampler> diffuse_sampler = MakeRef<CosineHemiSphereSampler>();
-            const Ref<Sampler> specular_sampler = MakeRef<BlinnPhongSpecularSampler>(mat->ns);
-            sampler = MakeRef<MixSampler>(
-                std::vector<Ref<Sampler>>{diffuse_sampler, specular_sampler},
-                std::vector<double>{mat->diffuse_tex->Sample(texcoord).norm(), mat->specular_tex->Sample(texcoord).norm()}
-            );
+            const Real survive_prob = std::min(throughput.maxCoeff(), (Real)1.0 - stop_prob);
+            if (RNG::Rand(dist) >= survive_prob)
+            {
+                break;
+            }
+            throughput /= survive_prob;
         }
-        else
+
+        const BSDFSampler sampler = BSDFSampler::From(context);
+
+        // Next Event Estimation: One Light Sample, Tested With A Shadow Ray, Weighted Against The BSDF Sampler.
+        if (LightList::LightSample light; !lights.IsEmpty() && lights.Sample(origin, normal, RNG::Rand(dist), Vector2r{ RNG::Rand(dist), RNG::Rand(dist) }, light))
         {
-            ASSERT(false);
+            const Real cos_surface = normal.dot(light.omega);
+            // Trimmed At Both Ends So The Shadow Ray Hits Neither The Surface Nor The Light Itself.
+            const Real t_min = SpawnEpsilon(origin);
+            const Real t_max = FIsInfinity(light.distance) ? INF : light.distance - SpawnEpsilon(origin + light.distance * light.omega);
+            if (cos_surface > (Real)0.0 && t_min < t_max && !hittable->Occluded(Ray(origin, light.omega), Interval{ t_min, t_max }))
+            {
+                // std::max Maps A NaN PDF (Specular Lobe Facing Away From omega_o) To 0.
+                const Real bsdf_pdf = std::max((Real)0.0, sampler.PDF(origin, interaction.texcoord, normal, light.omega, omega_o));
+                const Real weight = PowerHeuristic(light.pdf, bsdf_pdf);
+                L.array() += throughput.array() * light.radiance.array() * context.BRDF(normal, light.omega, omega_o).array() * (weight * cos_surface / light.pdf);
+            }
         }
 
-        // sampler = MakeRef<MixSampler>(
-        //     std::vector<Ref<Sampler>>{sampler, MakeRef<LightImportanceSampler>(lights)},
-        //     std::vector<double>{0.5, 0.5}
-        // );
+        const Vector3r omega_i = sampler.Sample(origin, interaction.texcoord, normal, omega_o);
+        const Real pdf = sampler.PDF(origin, interaction.texcoord, normal, omega_i, omega_o);
 
-        const Eigen::Vector3d omega_i = sampler->Sample(origin, texcoord, normal, omega_o);
-        const double pdf = sampler->PDF(origin, texcoord, normal, omega_i, omega_o);
+        // Grazing Samples Can Round To A Zero Or NaN PDF, Far More Often With Real = float. Either Would Poison The Pixel.
+        // The Specular Lobe Can Also Reflect Below The Surface, Where The Light Sample Above Does Not Look Either.
+        if (!(pdf > (Real)0.0) || !(normal.dot(omega_i) > (Real)0.0)) UNLIKELY
+        {
+            break;
+        }
 
-        Eigen::Vector3d Li = RayCast(Ray(record.hit_point, omega_i), hittable, lights, bounce + 1, stop_prob);
-        Eigen::Vector3d fr = material->BRDF(texcoord, normal, omega_i, omega_o);
-        Lo.array() += (Li.array() * fr.array() * normal.dot(omega_i)) / (bounce < min_bounce ? pdf : pdf * (1.0 - stop_prob));
+        throughput.array() *= context.BRDF(normal, omega_i, omega_o).array() * (normal.dot(omega_i) / pdf);
+        path_ray = Ray(origin, omega_i);
+        path_pdf = pdf;
+        path_normal = normal;
     }
 
-    return Lo;
+    return L;
 }
 
-void Renderer::Render(const Camera& camera, const Ref<Hittable>& scene, const std::vector<Ref<Hittable>>& lights, const RenderConfig& config, Image& film) NOEXCEPT
+void Renderer::Render(const Camera& camera, const Ref<Hittable>& scene, const LightList& lights, const RenderConfig& config, Image& film) NOEXCEPT
 {
     film.data.resize(camera.height, camera.width);
 
     RNG::Seed(std::random_device()());
+
+    if (config.target_error > (Real)0.0)
+    {
+        RenderAdaptive(camera, scene, lights, config, film);
+        return;
+    }
+
     auto dist = RNG::UniformDist<unsigned int>(0, std::numeric_limits<unsigned int>::max());
 
-    const Eigen::Index jitter_size = (Eigen::Index)SSqrt((double)config.SPP);
+    const Eigen::Index jitter_size = (Eigen::Index)SSqrt((Real)config.SPP);
     #ifdef NDEBUG
-    static std::vector<std::future<Eigen::Vector3d>> futures(jitter_size * jitter_size);
+    static std::vector<std::future<Vector3r>> futures(jitter_size * jitter_size);
     #endif
-    const double spp_norm_factor = 1.0 / (double)(jitter_size * jitter_size);
+    const Real spp_norm_factor = (Real)1.0 / (Real)(jitter_size * jitter_size);
+
+    const auto st = Debug::Now();
 
     for (Eigen::Index row = 0, progress = 0, acc = 0; row < film.Height(); ++row)
     {
         for (Eigen::Index col = 0; col < film.Width(); ++col, ++progress, (++acc) %= 3)
         {
-            Eigen::Vector3d color = Eigen::Vector3d{ 0.0, 0.0, 0.0 };
+            Vector3r color = Vector3r{ 0.0, 0.0, 0.0 };
 
             for (Eigen::Index jitter_row = 0, jitter_index = 0; jitter_row < jitter_size; ++jitter_row)
             {
                 for (Eigen::Index jitter_col = 0; jitter_col < jitter_size; ++jitter_col, ++jitter_index)
                 {
                     #ifdef NDEBUG
-                    futures[jitter_index] = THREAD_POOL.Submit([&camera, &scene, &lights, &config, row, col, jitter_size, jitter_row, jitter_col](const unsigned int seed) -> Eigen::Vector3d
+                    futures[jitter_index] = THREAD_POOL.Submit([&camera, &scene, &lights, &config, row, col, jitter_size, jitter_row, jitter_col](const unsigned int seed) -> Vector3r
                     {
                         RNG::Seed(seed);
                         const Ray sample_ray = camera.SampleRay(row, col, jitter_size, jitter_row, jitter_col);
-                        return RayCast(sample_ray, scene, lights, 0, config.stop_prob);
+                        return RayCast(sample_ray, scene, lights, config.stop_prob);
                     }, RNG::Rand(dist));
                     #else
-                    color += [&camera, &scene, &lights, &config, row, col, jitter_size, jitter_row, jitter_col](const unsigned int seed) -> Eigen::Vector3d
+                    color += [&camera, &scene, &lights, &config, row, col, jitter_size, jitter_row, jitter_col](const unsigned int seed) -> Vector3r
                     {
                         RNG::Seed(seed);
                         const Ray sample_ray = camera.SampleRay(row, col, jitter_size, jitter_row, jitter_col);
-                        return RayCast(sample_ray, scene, lights, 0, config.stop_prob);
+                        return RayCast(sample_ray, scene, lights, config.stop_prob);
                     }(RNG::Rand(dist));
                     #endif
                 }
@@ -128,14 +307,14 @@ void Renderer::Render(const Camera& camera, const Ref<Hittable>& scene, const st
             // for (Eigen::Index i = 0; i < config.SPP; ++i)
             // {
             //     #ifdef NDEBUG
-            //     futures[i] = THREAD_POOL.Submit([&camera, &hittable, &config, row, col](const unsigned int seed) -> Eigen::Vector3d
+            //     futures[i] = THREAD_POOL.Submit([&camera, &hittable, &config, row, col](const unsigned int seed) -> Vector3r
             //     {
             //         RNG::Seed(seed);
             //         const Ray sample_ray = camera.SampleRay(row, col);
             //         return RayCast(sample_ray, hittable, 0, config.stop_prob);
             //     }, RNG::Rand(dist));
             //     #else
-            //     color += [&camera, &hittable, &config, row, col](const unsigned int seed) -> Eigen::Vector3d
+            //     color += [&camera, &hittable, &config, row, col](const unsigned int seed) -> Vector3r
             //     {
             //         RNG::Seed(seed);
             //         const Ray sample_ray = camera.SampleRay(row, col);
@@ -164,5 +343,12 @@ void Renderer::Render(const Camera& camera, const Ref<Hittable>& scene, const st
         }
     }
 
+    const auto ed = Debug::Now();
+
     std::clog << "\rProgress 100.00% Complete!" << std::endl;
+
+    // NOTE: Primary Rays Per Second. Comparable Between Builds Of The Same Scene And SPP.
+    const double rays = (double)(film.Height() * film.Width() * jitter_size * jitter_size);
+    const double microseconds = (double)std::max<size_t>(Debug::MicroSeconds(ed - st), 1);
+    std::clog << "Throughput: " << std::fixed << std::setprecision(3) << rays / microseconds << " MRays/s" << std::endl;
 }
@@ -19,18 +19,25 @@ struct Ray;
 struct Hittable;
 struct Camera;
 struct Image;
+struct LightList;
 
 struct RenderConfig
 {
     const Eigen::Index SPP;
-    const double stop_prob;
+    const Real stop_prob; // Lower Bound Of The Russian Roulette Termination Probability.
+    // Adaptive Sampling When Positive: Pixels Stop Once The Relative Standard Error Of Their Mean Is Below This, SPP
+    // Then Caps Each Pixel. 0 Spends Exactly SPP (Rounded Down To A Square) On Every Pixel.
+    const Real target_error;
 };
 
 struct Renderer
 {
-    NODISCARD static Eigen::Vector3d RayCast(const Ray& ray, const Ref<Hittable>& hittable, const std::vector<Ref<Hittable>>& lights, Eigen::Index bounce, double stop_prob) NOEXCEPT;
+    // Iterative, Stack Use Does Not Grow With Path Length.
+    // Samples lights Directly At Every Vertex And Combines That With BSDF Sampled Hits On lights By Multiple Importance Sampling.
+    // Rays Leaving The Scene See lights.environment, Black Without One.
+    NODISCARD static Vector3r RayCast(const Ray& ray, const Ref<Hittable>& hittable, const LightList& lights, Real stop_prob) NOEXCEPT;
 
-    static void Render(const Camera& camera, const Ref<Hittable>& scene, const std::vector<Ref<Hittable>>& lights, const RenderConfig& config, Image& film) NOEXCEPT;
+    static void Render(const Camera& camera, const Ref<Hittable>& scene, const LightList& lights, const RenderConfig& config, Image& film) NOEXCEPT;
 };
 
 #endif //RENDERER_H
@@ -0,0 +1,456 @@
+/**
+  ******************************************************************************
+  * @file           : SBVHBuilder.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-27
+  ******************************************************************************
+  */
+
+
+
+#include <Core/SBVHBuilder.h>
+#include <Core/Debug.h>
+
+namespace
+{
+
+using Primitive = BVHBuilder::Primitive;
+
+// Beyond This Depth Split By Count Only, Which Bounds The Depth By MAX_SAH_DEPTH + log2(N).
+CONSTEXPR Eigen::Index MAX_SAH_DEPTH = 32;
+
+struct Box
+{
+    Eigen::Vector3d bmin = Eigen::Vector3d::Constant(INF);
+    Eigen::Vector3d bmax = Eigen::Vector3d::Constant(-INF);
+
+    FORCE_INLINE void Merge(const Eigen::Vector3d& lo, const Eigen::Vector3d& hi) NOEXCEPT
+    {
+        bmin = bmin.cwiseMin(lo);
+        bmax = bmax.cwiseMax(hi);
+    }
+
+    FORCE_INLINE void Merge(const Box& oth) NOEXCEPT { Merge(oth.bmin, oth.bmax); }
+
+    NODISCARD FORCE_INLINE bool IsEmpty() const NOEXCEPT
+    {
+        return (bmin.array() > bmax.array()).any();
+    }
+
+    NODISCARD FORCE_INLINE double Area() const NOEXCEPT
+    {
+        return IsEmpty() ? 0.0 : BVHBuilder::SurfaceArea(bmin, bmax);
+    }
+
+    NODISCARD FORCE_INLINE static Box Union(Box box, const Primitive& primitive) NOEXCEPT
+    {
+        box.Merge(primitive.bmin, primitive.bmax);
+        return box;
+    }
+};
+
+struct Builder
+{
+    const BVHConfig& config;
+    const SBVHBuilder::Clip& clip;
+    double inv_root_area;
+    Eigen::Index budget; // References Left To Duplicate.
+    std::vector<Eigen::Index>& order;
+
+    struct ObjectSplit
+    {
+        double cost = INF;
+        Eigen::Index axis = 0;
+        Eigen::Index bin = 0;
+        double cmin = 0.0;
+        double scale = 0.0;
+        Box left, right;
+    };
+
+    struct SpatialSplit
+    {
+        double cost = INF;
+        Eigen::Index axis = 0;
+        double position = 0.0;
+    };
+
+    NODISCARD FORCE_INLINE double SplitCost(const double inv_area, const Eigen::Index left_count, const double left_area, const Eigen::Index right_count, const double right_area) const NOEXCEPT
+    {
+        return config.traversal_cost + config.intersection_cost * inv_area * ((double)left_count * left_area + (double)right_count * right_area);
+    }
+
+    void ClipReference(const Primitive& reference, const Eigen::Index axis, const double position, Primitive& left, Primitive& right) const NOEXCEPT
+    {
+        left = reference;
+        right = reference;
+        if (clip != nullptr)
+        {
+            clip(reference, axis, position, left, right);
+        }
+
+        left.bmin = left.bmin.cwiseMax(reference.bmin);
+        left.bmax = left.bmax.cwiseMin(reference.bmax);
+        left.bmax[axis] = std::min(left.bmax[axis], position);
+        right.bmin = right.bmin.cwiseMax(reference.bmin);
+        right.bmax = right.bmax.cwiseMin(reference.bmax);
+        right.bmin[axis] = std::max(right.bmin[axis], position);
+
+        left.center = 0.5 * (left.bmin + left.bmax);
+        right.center = 0.5 * (right.bmin + right.bmax);
+        left.index = right.index = reference.index;
+    }
+
+    NODISCARD ObjectSplit FindObjectSplit(const std::vector<Primitive>& references, const Box& centroids, const double inv_area) const NOEXCEPT
+    {
+        const Eigen::Index bin_count = std::max<Eigen::Index>(config.bin_count, 2);
+        const Eigen::Index count = (Eigen::Index)references.size();
+
+        ObjectSplit best;
+        std::vector<Box> bins(bin_count);
+        std::vector<Eigen::Index> counts(bin_count);
+        std::vector<Box> right_boxes(bin_count);
+        for (Eigen::Index axis = 0; axis < 3; ++axis)
+        {
+            const double extent = centroids.bmax[axis] - centroids.bmin[axis];
+            if (extent <= 0.0) { continue; }
+            const double scale = (double)bin_count / extent;
+            const double cmin = centroids.bmin[axis];
+
+            std::fill(bins.begin(), bins.end(), Box{});
+            std::fill(counts.begin(), counts.end(), 0);
+            for (const Primitive& reference : references)
+            {
+                const Eigen::Index bin = std::min((Eigen::Index)((reference.center[axis] - cmin) * scale), bin_count - 1);
+                bins[bin].Merge(reference.bmin, reference.bmax);
+                ++counts[bin];
+            }
+
+            Box acc;
+            for (Eigen::Index k = bin_count - 1; k > 0; --k)
+            {
+                acc.Merge(bins[k]);
+                right_boxes[k - 1] = acc;
+            }
+
+            acc = Box{};
+            Eigen::Index left_count = 0;
+            for (Eigen::Index k = 0; k < bin_count - 1; ++k)
+            {
+                acc.Merge(bins[k]);
+                left_count += counts[k];
+                const Eigen::Index right_count = count - left_count;
+                if (left_count == 0 || right_count == 0) { continue; }
+                const double cost = SplitCost(inv_area, left_count, acc.Area(), right_count, right_boxes[k].Area());
+                if (cost < best.cost)
+                {
+                    best = ObjectSplit{ cost, axis, k, cmin, scale, acc, right_boxes[k] };
+                }
+            }
+        }
+        return best;
+    }
+
+    NODISCARD SpatialSplit FindSpatialSplit(const std::vector<Primitive>& references, const Box& bounds, const double inv_area) const NOEXCEPT
+    {
+        const Eigen::Index bin_count = std::max<Eigen::Index>(config.bin_count, 2);
+
+        SpatialSplit best;
+        std::vector<Box> bins(bin_count);
+        std::vector<Eigen::Index> entries(bin_count);
+        std::vector<Eigen::Index> exits(bin_count);
+        std::vector<Box> right_boxes(bin_count);
+        std::vector<Eigen::Index> right_counts(bin_count);
+        for (Eigen::Index axis = 0; axis < 3; ++axis)
+        {
+            const double origin = bounds.bmin[axis];
+            const double extent = bounds.bmax[axis] - origin;
+            if (extent <= 0.0) { continue; }
+            const double scale = (double)bin_count / extent;
+            const auto bin_of = [origin, scale, bin_count](const double x) -> Eigen::Index
+            {
+                return std::clamp((Eigen::Index)((x - origin) * scale), (Eigen::Index)0, bin_count - 1);
+            };
+            const auto plane_of = [origin, extent, bin_count](const Eigen::Index k) -> double
+            {
+                return origin + extent * (double)(k + 1) / (double)bin_count;
+            };
+
+            std::fill(bins.begin(), bins.end(), Box{});
+            std::fill(entries.begin(), entries.end(), 0);
+            std::fill(exits.begin(), exits.end(), 0);
+            for (const Primitive& reference : references)
+            {
+                const Eigen::Index first = bin_of(reference.bmin[axis]);
+                const Eigen::Index last = std::max(first, bin_of(reference.bmax[axis]));
+                ++entries[first];
+                ++exits[last];
+
+                // Chop The Reference Into Every Bin It Covers.
+                Primitive rest = reference;
+                for (Eigen::Index k = first; k < last; ++k)
+                {
+                    Primitive left, right;
+                    ClipReference(rest, axis, plane_of(k), left, right);
+                    if (!Box{ left.bmin, left.bmax }.IsEmpty()) { bins[k].Merge(left.bmin, left.bmax); }
+                    rest = right;
+                }
+                if (!Box{ rest.bmin, rest.bmax }.IsEmpty()) { bins[last].Merge(rest.bmin, rest.bmax); }
+            }
+
+            Box acc;
+            Eigen::Index right_count = 0;
+            for (Eigen::Index k = bin_count - 1; k > 0; --k)
+            {
+                acc.Merge(bins[k]);
+                right_count += exits[k];
+                right_boxes[k - 1] = acc;
+                right_counts[k - 1] = right_count;
+            }
+
+            acc = Box{};
+            Eigen::Index left_count = 0;
+            for (Eigen::Index k = 0; k < bin_count - 1; ++k)
+            {
+                acc.Merge(bins[k]);
+                left_count += entries[k];
+                if (left_count == 0 || right_counts[k] == 0) { continue; }
+                const double cost = SplitCost(inv_area, left_count, acc.Area(), right_counts[k], right_boxes[k].Area());
+                if (cost < best.cost)
+                {
+                    best = SpatialSplit{ cost, axis, plane_of(k) };
+                }
+            }
+        }
+        return best;
+    }
+
+    // Straddling References Are Either Clipped Into Both Children Or Kept Whole On One Side ("Reference Unsplitting").
+    void PerformSpatialSplit(std::vector<Primitive>& references, const SpatialSplit& split, std::vector<Primitive>& left, std::vector<Primitive>& right) NOEXCEPT
+    {
+        const Eigen::Index axis = split.axis;
+        const double position = split.position;
+
+        Box left_box, right_box;
+        std::vector<Primitive> straddling;
+        for (const Primitive& reference : references)
+        {
+            if (reference.bmax[axis] <= position)
+            {
+                left_box.Merge(reference.bmin, reference.bmax);
+                left.push_back(reference);
+            }
+            else if (reference.bmin[axis] >= position)
+            {
+                right_box.Merge(reference.bmin, reference.bmax);
+                right.push_back(reference);
+            }
+            else
+            {
+                straddling.push_back(reference);
+            }
+        }
+
+        for (const Primitive& reference : straddling)
+        {
+            const double left_count = (double)left.size();
+            const double right_count = (double)right.size();
+
+            Primitive left_part, right_part;
+            ClipReference(reference, axis, position, left_part, right_part);
+            const bool left_valid = !Box{ left_part.bmin, left_part.bmax }.IsEmpty();
+            const bool right_valid = !Box{ right_part.bmin, right_part.bmax }.IsEmpty();
+
+            // NOTE: The Clip Function May Find The Primitive Entirely On One Side Even Though Its Box Straddles.
+            if (!left_valid || !right_valid)
+            {
+                const Primitive& part = left_valid ? left_part : right_part;
+                (left_valid ? left_box : right_box).Merge(part.bmin, part.bmax);
+                (left_valid ? left : right).push_back(part);
+                continue;
+            }
+
+            const double cost_left = Box::Union(left_box, reference).Area() * (left_count + 1.0) + right_box.Area() * right_count;
+            const double cost_right = left_box.Area() * left_count + Box::Union(right_box, reference).Area() * (right_count + 1.0);
+            const double cost_split = budget > 0
+                ? Box::Union(left_box, left_part).Area() * (left_count + 1.0) + Box::Union(right_box, right_part).Area() * (right_count + 1.0)
+                : INF;
+
+            if (cost_split < cost_left && cost_split < cost_right)
+            {
+                left_box.Merge(left_part.bmin, left_part.bmax);
+                right_box.Merge(right_part.bmin, right_part.bmax);
+                left.push_back(left_part);
+                right.push_back(right_part);
+                --budget;
+            }
+            else if (cost_left <= cost_right)
+            {
+                left_box.Merge(reference.bmin, reference.bmax);
+                left.push_back(reference);
+            }
+            else
+            {
+                right_box.Merge(reference.bmin, reference.bmax);
+                right.push_back(reference);
+            }
+        }
+    }
+
+    void MakeLeaf(const std::vector<Primitive>& references, BVHBuildNode& node) const NOEXCEPT
+    {
+        node.begin = (Eigen::Index)order.size();
+        node.count = (Eigen::Index)references.size();
+        for (const Primitive& reference : references)
+        {
+            order.push_back(reference.index);
+        }
+    }
+
+    void Build(std::vector<Primitive> references, const Eigen::Index depth, BVHBuildNode& node) NOEXCEPT // NOLINT(*-no-recursion)
+    {
+        ASSERT(!references.empty());
+
+        Box bounds, centroids;
+        for (const Primitive& reference : references)
+        {
+            bounds.Merge(reference.bmin, reference.bmax);
+            centroids.Merge(reference.center, reference.center);
+        }
+
+        node.bmin = bounds.bmin;
+        node.bmax = bounds.bmax;
+        node.axis = 0;
+        node.count = 0;
+
+        const Eigen::Index count = (Eigen::Index)references.size();
+        if (count == 1)
+        {
+            MakeLeaf(references, node);
+            return;
+        }
+
+        std::vector<Primitive> left, right;
+
+        if (depth < MAX_SAH_DEPTH)
+        {
+            const double area = bounds.Area();
+            const double inv_area = area > 0.0 ? 1.0 / area : 0.0;
+
+            const ObjectSplit object = FindObjectSplit(references, centroids, inv_area);
+
+            // Spatial Splits Only Pay Off Where The Object Split Children Overlap Noticeably.
+            SpatialSplit spatial;
+            if (budget > 0)
+            {
+                Box overlap;
+                overlap.bmin = object.left.bmin.cwiseMax(object.right.bmin);
+                overlap.bmax = object.left.bmax.cwiseMin(object.right.bmax);
+                if (object.cost == INF || overlap.Area() * inv_root_area > config.spatial_split_alpha)
+                {
+                    spatial = FindSpatialSplit(references, bounds, inv_area);
+                }
+            }
+
+            const double leaf_cost = config.intersection_cost * (double)count;
+            if (count <= config.max_leaf_size && leaf_cost <= std::min(object.cost, spatial.cost))
+            {
+                MakeLeaf(references, node);
+                return;
+            }
+
+            if (spatial.cost < object.cost)
+            {
+                node.axis = spatial.axis;
+                PerformSpatialSplit(references, spatial, left, right);
+            }
+            else if (object.cost < INF)
+            {
+                node.axis = object.axis;
+                for (const Primitive& reference : references)
+                {
+                    const Eigen::Index bin = std::min((Eigen::Index)((reference.center[object.axis] - object.cmin) * object.scale), std::max<Eigen::Index>(config.bin_count, 2) - 1);
+                    (bin <= object.bin ? left : right).push_back(reference);
+                }
+            }
+        }
+        else if (count <= config.max_leaf_size)
+        {
+            MakeLeaf(references, node);
+            return;
+        }
+
+        // Fallback: Coincident Centroids, Too Deep Or No Valid Split, Halve By Count.
+        if (left.empty() || right.empty())
+        {
+            left.clear();
+            right.clear();
+            Eigen::Index axis;
+            (centroids.bmax - centroids.bmin).maxCoeff(&axis);
+            node.axis = axis;
+            const auto mid = references.begin() + count / 2;
+            std::nth_element(references.begin(), mid, references.end(),
+                [axis](const Primitive& lhs, const Primitive& rhs) -> bool
+                {
+                    return lhs.center[axis] < rhs.center[axis];
+                }
+            );
+            left.assign(references.begin(), mid);
+            right.assign(mid, references.end());
+        }
+
+        // Release The Parent References Before Descending, Peak Memory Stays Near The Reference Count.
+        references.clear();
+        references.shrink_to_fit();
+
+        node.children[0] = MakeUni<BVHBuildNode>();
+        node.children[1] = MakeUni<BVHBuildNode>();
+        Build(std::move(left), depth + 1, *node.children[0]);
+        Build(std::move(right), depth + 1, *node.children[1]);
+    }
+};
+
+}
+
+NODISCARD BVHBuilder::Result SBVHBuilder::Build(const std::vector<BVHBuilder::Primitive>& primitives, const BVHConfig& config, const Clip& clip) NOEXCEPT
+{
+    BVHBuilder::Result result;
+
+    if (primitives.empty()) UNLIKELY
+    {
+        return result;
+    }
+
+    const auto st = Debug::Now();
+
+    const Eigen::Index primitive_count = (Eigen::Index)primitives.size();
+
+    Box root;
+    for (const Primitive& primitive : primitives)
+    {
+        root.Merge(primitive.bmin, primitive.bmax);
+    }
+    const double root_area = root.Area();
+
+    Builder builder{
+        config,
+        clip,
+        root_area > 0.0 ? 1.0 / root_area : 0.0,
+        (Eigen::Index)(config.spatial_split_budget * (double)primitive_count),
+        result.order,
+    };
+    result.order.reserve(primitive_count + builder.budget);
+
+    result.root = MakeUni<BVHBuildNode>();
+    builder.Build(primitives, 1, *result.root);
+
+    result.statistics = BVHBuilder::Statistics(*result.root, config);
+    result.statistics.primitive_count = primitive_count;
+    result.statistics.reference_count = (Eigen::Index)result.order.size();
+
+    const auto ed = Debug::Now();
+    result.statistics.build_time = Debug::MicroSeconds(ed - st);
+
+    return result;
+}
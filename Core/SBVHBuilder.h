@@ -0,0 +1,31 @@
+/**
+  ******************************************************************************
+  * @file           : SBVHBuilder.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-27
+  ******************************************************************************
+  */
+
+
+
+#ifndef SBVH_BUILDER_H
+#define SBVH_BUILDER_H
+
+#include <Core/Common.h>
+#include <Core/BVHBuilder.h>
+
+// Spatial Split BVH. Ref: https://www.nvidia.com/docs/IO/77714/sbvh.pdf
+// Straddling References Are Clipped Against The Split Plane, So A Primitive May Appear In Several Leaves.
+struct SBVHBuilder
+{
+    // Bounds Of The Parts Of reference.index On Each Side Of The Plane. The Builder Intersects Them With reference.
+    // Without A Clip Function The Reference Box Itself Is Cut, Which Is Valid For Any Primitive But Looser.
+    using Clip = std::function<void(const BVHBuilder::Primitive& reference, Eigen::Index axis, double position, BVHBuilder::Primitive& left, BVHBuilder::Primitive& right)>;
+
+    // Same Contract As BVHBuilder::Build, Except That result.order May Repeat Primitive Indices.
+    NODISCARD static BVHBuilder::Result Build(const std::vector<BVHBuilder::Primitive>& primitives, const BVHConfig& config, const Clip& clip = nullptr) NOEXCEPT;
+};
+
+#endif //SBVH_BUILDER_H
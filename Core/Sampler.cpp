@@ -11,3 +11,21 @@
 
 
 #include <Core/Sampler.h>
+#include <Core/Material.h>
+
+NODISCARD BSDFSampler BSDFSampler::From(const ShadingContext& context) NOEXCEPT
+{
+    switch (context.kind)
+    {
+    case PackedMaterial::PACKED_MATERIAL_KIND_BLINNPHONG:
+    {
+        // Lobes Weighted By Albedo Like The MixSampler Did.
+        const Real diffuse = context.diffuse.norm();
+        const Real specular = context.specular.norm();
+        return BSDFSampler{ BSDF_SAMPLER_KIND_BLINNPHONG, context.ns, diffuse / (diffuse + specular) };
+    }
+    case PackedMaterial::PACKED_MATERIAL_KIND_LAMBERT:
+    default:
+        return BSDFSampler{ BSDF_SAMPLER_KIND_COSINE, (Real)0.0, (Real)1.0 };
+    }
+}
@@ -21,28 +21,28 @@ struct Sampler
 {
     virtual ~Sampler() NOEXCEPT = default;
 
-    NODISCARD virtual Eigen::Vector3d /* omega_i */ Sample(
-        const Eigen::Vector3d& origin,
-        const Eigen::Vector2d& texcoord,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_o
+    NODISCARD virtual Vector3r /* omega_i */ Sample(
+        const Vector3r& origin,
+        const Vector2r& texcoord,
+        const Vector3r& normal,
+        const Vector3r& omega_o
     ) const NOEXCEPT = 0;
 
-    NODISCARD virtual double PDF(
-        const Eigen::Vector3d& origin,
-        const Eigen::Vector2d& texcoord,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_i,
-        const Eigen::Vector3d& omega_o
+    NODISCARD virtual Real PDF(
+        const Vector3r& origin,
+        const Vector2r& texcoord,
+        const Vector3r& normal,
+        const Vector3r& omega_i,
+        const Vector3r& omega_o
     ) const NOEXCEPT = 0;
 };
 
 struct MixSampler final : Sampler
 {
     std::vector<Ref<Sampler>> samplers;
-    std::vector<double> cdf;
+    std::vector<Real> cdf;
 
-    NODISCARD MixSampler(std::vector<Ref<Sampler>> samplers, const std::vector<double>& weights) NOEXCEPT
+    NODISCARD MixSampler(std::vector<Ref<Sampler>> samplers, const std::vector<Real>& weights) NOEXCEPT
     : samplers(std::move(samplers)), cdf(weights.size() + 1)
     {
         cdf[0] = 0.0;
@@ -56,15 +56,15 @@ struct MixSampler final : Sampler
         }
     }
 
-    NODISCARD Eigen::Vector3d /* omega_i */ Sample(
-        const Eigen::Vector3d& origin,
-        const Eigen::Vector2d& texcoord,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_o
+    NODISCARD Vector3r /* omega_i */ Sample(
+        const Vector3r& origin,
+        const Vector2r& texcoord,
+        const Vector3r& normal,
+        const Vector3r& omega_o
     ) const NOEXCEPT OVERRIDE
     {
-        auto dist = RNG::UniformDist<double>(0.0, 1.0);
-        const double rng = RNG::Rand(dist);
+        auto dist = RNG::UniformDist<Real>(0.0, 1.0);
+        const Real rng = RNG::Rand(dist);
         for (size_t i = 1; i <= samplers.size(); ++i)
         {
             if (Fle(rng, cdf[i]))
@@ -75,15 +75,15 @@ struct MixSampler final : Sampler
         return samplers.back()->Sample(origin, texcoord, normal, omega_o);
     }
 
-    NODISCARD double PDF(
-        const Eigen::Vector3d& origin,
-        const Eigen::Vector2d& texcoord,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_i,
-        const Eigen::Vector3d& omega_o
+    NODISCARD Real PDF(
+        const Vector3r& origin,
+        const Vector2r& texcoord,
+        const Vector3r& normal,
+        const Vector3r& omega_i,
+        const Vector3r& omega_o
     ) const NOEXCEPT OVERRIDE
     {
-        double pdf = 0.0;
+        Real pdf = 0.0;
         for (size_t i = 1; i <= samplers.size(); ++i)
         {
             pdf += (cdf[i] - cdf[i - 1]) * samplers[i - 1]->PDF(origin, texcoord, normal, omega_i, omega_o);
@@ -94,59 +94,59 @@ struct MixSampler final : Sampler
 
 struct UniformHemiSphereSampler final : Sampler
 {
-    NODISCARD Eigen::Vector3d /* omega_i */ Sample(
-        const Eigen::Vector3d& origin UNUSED,
-        const Eigen::Vector2d& texcoord UNUSED,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_o UNUSED
+    NODISCARD Vector3r /* omega_i */ Sample(
+        const Vector3r& origin UNUSED,
+        const Vector2r& texcoord UNUSED,
+        const Vector3r& normal,
+        const Vector3r& omega_o UNUSED
     ) const NOEXCEPT OVERRIDE
     {
-        auto dist = RNG::UniformDist<double>(0.0, 1.0);
-        const double zeta_1 = RNG::Rand(dist);
-        const double zeta_2 = RNG::Rand(dist);
-        const double cos_theta = zeta_1 * 2.0 - 1.0;
-        const double sin_theta = SSqrt(1.0 - cos_theta * cos_theta);
-        const double phi = zeta_2 * 2.0 * PI;
-        Eigen::Vector3d omega_i = { cos_theta, sin_theta * std::cos(phi), sin_theta * std::sin(phi) };
+        auto dist = RNG::UniformDist<Real>(0.0, 1.0);
+        const Real zeta_1 = RNG::Rand(dist);
+        const Real zeta_2 = RNG::Rand(dist);
+        const Real cos_theta = zeta_1 * (Real)2.0 - (Real)1.0;
+        const Real sin_theta = SSqrt((Real)1.0 - cos_theta * cos_theta);
+        const Real phi = zeta_2 * (Real)2.0 * PI;
+        Vector3r omega_i = { cos_theta, sin_theta * std::cos(phi), sin_theta * std::sin(phi) };
         return FIsNegative(omega_i.dot(normal)) ? -omega_i : omega_i;
     }
 
-    NODISCARD double PDF(
-        const Eigen::Vector3d& origin UNUSED,
-        const Eigen::Vector2d& texcoord UNUSED,
-        const Eigen::Vector3d& normal UNUSED,
-        const Eigen::Vector3d& omega_i UNUSED,
-        const Eigen::Vector3d& omega_o UNUSED
+    NODISCARD Real PDF(
+        const Vector3r& origin UNUSED,
+        const Vector2r& texcoord UNUSED,
+        const Vector3r& normal UNUSED,
+        const Vector3r& omega_i UNUSED,
+        const Vector3r& omega_o UNUSED
     ) const NOEXCEPT OVERRIDE
     {
-        return 1.0 / (2.0 * PI);
+        return (Real)1.0 / ((Real)2.0 * PI);
     }
 };
 
 struct CosineHemiSphereSampler final : Sampler
 {
-    NODISCARD Eigen::Vector3d /* omega_i */ Sample(
-        const Eigen::Vector3d& origin UNUSED,
-        const Eigen::Vector2d& texcoord UNUSED,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_o UNUSED
+    NODISCARD Vector3r /* omega_i */ Sample(
+        const Vector3r& origin UNUSED,
+        const Vector2r& texcoord UNUSED,
+        const Vector3r& normal,
+        const Vector3r& omega_o UNUSED
     ) const NOEXCEPT OVERRIDE
     {
-        auto dist = RNG::UniformDist<double>(0.0, 1.0);
-        const double zeta_1 = RNG::Rand(dist);
-        const double zeta_2 = RNG::Rand(dist);
-        const double phi = 2.0 * PI * zeta_2;
-        const double cos_theta = SSqrt(zeta_1);
-        const double sin_theta = SSqrt(1.0 - zeta_1);
-        return ONB(normal).Transform(Eigen::Vector3d{ cos_theta, sin_theta * std::cos(phi), sin_theta * std::sin(phi) });
+        auto dist = RNG::UniformDist<Real>(0.0, 1.0);
+        const Real zeta_1 = RNG::Rand(dist);
+        const Real zeta_2 = RNG::Rand(dist);
+        const Real phi = (Real)2.0 * PI * zeta_2;
+        const Real cos_theta = SSqrt(zeta_1);
+        const Real sin_theta = SSqrt((Real)1.0 - zeta_1);
+        return ONB(normal).Transform(Vector3r{ cos_theta, sin_theta * std::cos(phi), sin_theta * std::sin(phi) });
     }
 
-    NODISCARD double PDF(
-        const Eigen::Vector3d& origin UNUSED,
-        const Eigen::Vector2d& texcoord UNUSED,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_i,
-        const Eigen::Vector3d& omega_o UNUSED
+    NODISCARD Real PDF(
+        const Vector3r& origin UNUSED,
+        const Vector2r& texcoord UNUSED,
+        const Vector3r& normal,
+        const Vector3r& omega_i,
+        const Vector3r& omega_o UNUSED
     ) const NOEXCEPT OVERRIDE
     {
         return normal.dot(omega_i) / PI;
@@ -155,64 +155,138 @@ struct CosineHemiSphereSampler final : Sampler
 
 struct BlinnPhongSpecularSampler final : Sampler
 {
-    double ns;
+    Real ns;
 
-    NODISCARD explicit BlinnPhongSpecularSampler(const double ns) NOEXCEPT : ns(ns) {}
+    NODISCARD explicit BlinnPhongSpecularSampler(const Real ns) NOEXCEPT : ns(ns) {}
 
-    NODISCARD Eigen::Vector3d /* omega_i */ Sample(
-        const Eigen::Vector3d& origin UNUSED,
-        const Eigen::Vector2d& texcoord UNUSED,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_o
+    NODISCARD Vector3r /* omega_i */ Sample(
+        const Vector3r& origin UNUSED,
+        const Vector2r& texcoord UNUSED,
+        const Vector3r& normal,
+        const Vector3r& omega_o
     ) const NOEXCEPT OVERRIDE
     {
-        auto dist = RNG::UniformDist<double>(0.0, 1.0);
-        const double zeta_1 = RNG::Rand(dist);
-        const double zeta_2 = RNG::Rand(dist);
-        const double phi = 2.0 * PI * zeta_2;
-        const double cos_theta = std::pow(zeta_1, 1.0 / (ns + 1.0));
-        const double sin_theta = SSqrt(1.0 - cos_theta * cos_theta);
-        const Eigen::Vector3d half = ONB(normal).Transform(Eigen::Vector3d{ cos_theta, sin_theta * std::cos(phi), sin_theta * std::sin(phi) });
-        return 2.0 * omega_o.dot(half) * half - omega_o;
+        auto dist = RNG::UniformDist<Real>(0.0, 1.0);
+        const Real zeta_1 = RNG::Rand(dist);
+        const Real zeta_2 = RNG::Rand(dist);
+        const Real phi = (Real)2.0 * PI * zeta_2;
+        const Real cos_theta = std::pow(zeta_1, (Real)1.0 / (ns + (Real)1.0));
+        const Real sin_theta = SSqrt((Real)1.0 - cos_theta * cos_theta);
+        const Vector3r half = ONB(normal).Transform(Vector3r{ cos_theta, sin_theta * std::cos(phi), sin_theta * std::sin(phi) });
+        return (Real)2.0 * omega_o.dot(half) * half - omega_o;
     }
 
-    NODISCARD double PDF(
-        const Eigen::Vector3d& origin UNUSED,
-        const Eigen::Vector2d& texcoord UNUSED,
-        const Eigen::Vector3d& normal,
-        const Eigen::Vector3d& omega_i,
-        const Eigen::Vector3d& omega_o
+    NODISCARD Real PDF(
+        const Vector3r& origin UNUSED,
+        const Vector2r& texcoord UNUSED,
+        const Vector3r& normal,
+        const Vector3r& omega_i,
+        const Vector3r& omega_o
     ) const NOEXCEPT OVERRIDE
     {
-        const Eigen::Vector3d half = (omega_i + omega_o).normalized();
-        return ((ns + 1.0) * std::pow(half.dot(normal), ns)) / (8.0 * PI * omega_o.dot(half));
+        const Vector3r half = (omega_i + omega_o).normalized();
+        return ((ns + (Real)1.0) * std::pow(half.dot(normal), ns)) / ((Real)8.0 * PI * omega_o.dot(half));
     }
 };
 
+struct ShadingContext;
+
+// Closed Set Of Material Samplers, Built On The Stack At Every Bounce. Sample And PDF Match The Sampler (Or
+// MixSampler Of Samplers) The Material Would Otherwise Allocate, Without Touching The Heap Or A Refcount.
+struct BSDFSampler
+{
+    enum BSDFSamplerKind
+    {
+        BSDF_SAMPLER_KIND_COSINE,     // CosineHemiSphereSampler.
+        BSDF_SAMPLER_KIND_BLINNPHONG, // MixSampler Of CosineHemiSphereSampler And BlinnPhongSpecularSampler.
+    };
+
+    BSDFSamplerKind kind;
+    Real ns;             // Blinn Phong Only.
+    Real diffuse_weight; // Blinn Phong Only: Probability Of Sampling The Cosine Lobe.
+
+    NODISCARD static BSDFSampler From(const ShadingContext& context) NOEXCEPT;
+
+    NODISCARD Vector3r /* omega_i */ Sample(
+        const Vector3r& origin,
+        const Vector2r& texcoord,
+        const Vector3r& normal,
+        const Vector3r& omega_o
+    ) const NOEXCEPT
+    {
+        switch (kind)
+        {
+        case BSDF_SAMPLER_KIND_BLINNPHONG:
+        {
+            auto dist = RNG::UniformDist<Real>(0.0, 1.0);
+            if (const Real rng = RNG::Rand(dist); !Fle(rng, diffuse_weight))
+            {
+                return BlinnPhongSpecularSampler(ns).Sample(origin, texcoord, normal, omega_o);
+            }
+            return CosineHemiSphereSampler().Sample(origin, texcoord, normal, omega_o);
+        }
+        case BSDF_SAMPLER_KIND_COSINE:
+        default:
+            return CosineHemiSphereSampler().Sample(origin, texcoord, normal, omega_o);
+        }
+    }
+
+    NODISCARD Real PDF(
+        const Vector3r& origin,
+        const Vector2r& texcoord,
+        const Vector3r& normal,
+        const Vector3r& omega_i,
+        const Vector3r& omega_o
+    ) const NOEXCEPT
+    {
+        switch (kind)
+        {
+        case BSDF_SAMPLER_KIND_BLINNPHONG:
+        {
+            Real pdf = diffuse_weight * CosineHemiSphereSampler().PDF(origin, texcoord, normal, omega_i, omega_o);
+            pdf += ((Real)1.0 - diffuse_weight) * BlinnPhongSpecularSampler(ns).PDF(origin, texcoord, normal, omega_i, omega_o);
+            return pdf;
+        }
+        case BSDF_SAMPLER_KIND_COSINE:
+        default:
+            return CosineHemiSphereSampler().PDF(origin, texcoord, normal, omega_i, omega_o);
+        }
+    }
+};
+
+// Weight Of A Sample Drawn With Density pdf When Another Strategy Could Have Drawn It With other_pdf. Both In Solid Angle Measure.
+// Ref: https://graphics.stanford.edu/papers/veach_thesis/ Section 9.2.4, Power Heuristic With beta = 2.
+NODISCARD FORCE_INLINE Real PowerHeuristic(const Real pdf, const Real other_pdf) NOEXCEPT
+{
+    const Real f = pdf * pdf;
+    const Real g = other_pdf * other_pdf;
+    return f / (f + g);
+}
+
 // struct LightImportanceSampler final : Sampler
 // {
 //     const std::vector<Ref<Hittable>>& lights;
 //
 //     NODISCARD explicit LightImportanceSampler(const std::vector<Ref<Hittable>>& lights) NOEXCEPT : lights(lights) {}
 //
-//     NODISCARD Eigen::Vector3d /* omega_i */ Sample(
-//         const Eigen::Vector3d& origin UNUSED,
-//         const Eigen::Vector2d& texcoord UNUSED,
-//         const Eigen::Vector3d& normal,
-//         const Eigen::Vector3d& omega_o UNUSED
+//     NODISCARD Vector3r /* omega_i */ Sample(
+//         const Vector3r& origin UNUSED,
+//         const Vector2r& texcoord UNUSED,
+//         const Vector3r& normal,
+//         const Vector3r& omega_o UNUSED
 //     ) const NOEXCEPT OVERRIDE
 //     {
-//         Eigen::Vector3d omega_i = {};
-//         double pdf = 0.0;
+//         Vector3r omega_i = {};
+//         Real pdf = 0.0;
 //
-//         auto dist1 = RNG::UniformDist<double>(213.0, 343.0);
-//         auto dist2 = RNG::UniformDist<double>(227.0, 332.0);
-//         auto on_light = Eigen::Vector3d(RNG::Rand(dist1), 554, RNG::Rand(dist2));
-//         Eigen::Vector3d to_light = on_light - origin;
+//         auto dist1 = RNG::UniformDist<Real>(213.0, 343.0);
+//         auto dist2 = RNG::UniformDist<Real>(227.0, 332.0);
+//         auto on_light = Vector3r(RNG::Rand(dist1), 554, RNG::Rand(dist2));
+//         Vector3r to_light = on_light - origin;
 //         auto distance_squared = to_light.squaredNorm();
 //         to_light = to_light.normalized();
 //
-//         double light_area = (343-213)*(332-227);
+//         Real light_area = (343-213)*(332-227);
 //         auto light_cosine = std::fabs(to_light.y());
 //
 //         pdf = distance_squared / (light_cosine * light_area);
@@ -223,12 +297,12 @@ struct BlinnPhongSpecularSampler final : Sampler
 //         return omega_i;
 //     }
 //
-//     NODISCARD double PDF(
-//         const Eigen::Vector3d& origin UNUSED,
-//         const Eigen::Vector2d& texcoord UNUSED,
-//         const Eigen::Vector3d& normal,
-//         const Eigen::Vector3d& omega_i,
-//         const Eigen::Vector3d& omega_o UNUSED
+//     NODISCARD Real PDF(
+//         const Vector3r& origin UNUSED,
+//         const Vector2r& texcoord UNUSED,
+//         const Vector3r& normal,
+//         const Vector3r& omega_i,
+//         const Vector3r& omega_o UNUSED
 //     ) const NOEXCEPT OVERRIDE
 //     {
 //         auto distance_squared = to_light.squaredNorm();
@@ -19,9 +19,23 @@
 template<typename T>
 struct Texture2D
 {
+protected:
+    enum Texture2DKind
+    {
+        TEXTURE2D_KIND_PURE_COLOR,
+        TEXTURE2D_KIND_CHECKER,
+        TEXTURE2D_KIND_IMAGE,
+    };
+
+    const Texture2DKind kind;
+
+public:
+    NODISCARD CONSTEXPR FORCE_INLINE Texture2DKind Kind() const NOEXCEPT { return kind; }
+
+    NODISCARD explicit Texture2D(const Texture2DKind kind) NOEXCEPT : kind(kind) {}
     virtual ~Texture2D() NOEXCEPT = default;
 
-    NODISCARD virtual T Sample(const Eigen::Vector2d& texcoord) const NOEXCEPT = 0;
+    NODISCARD virtual T Sample(const Vector2r& texcoord) const NOEXCEPT = 0;
 };
 
 template<typename T>
@@ -29,57 +43,93 @@ struct Texture3D
 {
     virtual ~Texture3D() NOEXCEPT = default;
 
-    NODISCARD virtual T Sample(const Eigen::Vector3d& texcoord) const NOEXCEPT = 0;
+    NODISCARD virtual T Sample(const Vector3r& texcoord) const NOEXCEPT = 0;
 };
 
-struct PureColorTexture2D final : Texture2D<Eigen::Vector3d>
+struct PureColorTexture2D final : Texture2D<Vector3r>
 {
-    Eigen::Vector3d color;
+    NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Texture2D* ptr) NOEXCEPT {return ptr->Kind() == TEXTURE2D_KIND_PURE_COLOR;}
 
-    NODISCARD explicit PureColorTexture2D(Eigen::Vector3d color) NOEXCEPT
-    : color(std::move(color))
+    Vector3r color;
+
+    NODISCARD explicit PureColorTexture2D(Vector3r color) NOEXCEPT
+    : Texture2D(TEXTURE2D_KIND_PURE_COLOR), color(std::move(color))
     {}
 
-    NODISCARD Eigen::Vector3d Sample(const Eigen::Vector2d &texcoord UNUSED) const NOEXCEPT OVERRIDE
+    NODISCARD Vector3r Sample(const Vector2r &texcoord UNUSED) const NOEXCEPT OVERRIDE
     {
         return color;
     }
 };
 
-struct CheckerTexture2D final : Texture2D<Eigen::Vector3d>
+struct CheckerTexture2D final : Texture2D<Vector3r>
 {
-    Eigen::Vector2d scale;
-    Eigen::Vector3d odd_color;
-    Eigen::Vector3d even_color;
+    NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Texture2D* ptr) NOEXCEPT {return ptr->Kind() == TEXTURE2D_KIND_CHECKER;}
+
+    Vector2r scale;
+    Vector3r odd_color;
+    Vector3r even_color;
 
-    NODISCARD explicit CheckerTexture2D(Eigen::Vector2d scale, Eigen::Vector3d odd_color, Eigen::Vector3d even_color) NOEXCEPT
-    : scale(std::move(scale)), odd_color(std::move(odd_color)), even_color(std::move(even_color))
+    NODISCARD explicit CheckerTexture2D(Vector2r scale, Vector3r odd_color, Vector3r even_color) NOEXCEPT
+    : Texture2D(TEXTURE2D_KIND_CHECKER), scale(std::move(scale)), odd_color(std::move(odd_color)), even_color(std::move(even_color))
     {}
 
-    NODISCARD Eigen::Vector3d Sample(const Eigen::Vector2d &texcoord) const NOEXCEPT OVERRIDE
+    NODISCARD Vector3r Sample(const Vector2r &texcoord) const NOEXCEPT OVERRIDE
     {
-        Eigen::Vector2d t = texcoord.array() * scale.array();
+        Vector2r t = texcoord.array() * scale.array();
         return (Eigen::Index)t.array().floor().sum() % 2 ? odd_color : even_color;
     }
 };
 
-struct ImageTexture2D final : Texture2D<Eigen::Vector3d>
+struct ImageTexture2D final : Texture2D<Vector3r>
 {
+    NODISCARD CONSTEXPR FORCE_INLINE static bool ClassOf(const Texture2D* ptr) NOEXCEPT {return ptr->Kind() == TEXTURE2D_KIND_IMAGE;}
+
     Ref<Image> image;
 
     NODISCARD explicit ImageTexture2D(const Ref<Image>& image) NOEXCEPT
-    : image(image)
+    : Texture2D(TEXTURE2D_KIND_IMAGE), image(image)
     {}
 
-    NODISCARD Eigen::Vector3d Sample(const Eigen::Vector2d &texcoord) const NOEXCEPT OVERRIDE
+    NODISCARD Vector3r Sample(const Vector2r &texcoord) const NOEXCEPT OVERRIDE
     {
-        const Eigen::Index col = (Eigen::Index)std::floor(texcoord.x() * (double)image->Width()) % image->Width();
-        const Eigen::Index row = (Eigen::Index)std::floor(texcoord.y() * (double)image->Height()) % image->Height();
+        const Eigen::Index col = (Eigen::Index)std::floor(texcoord.x() * (Real)image->Width()) % image->Width();
+        const Eigen::Index row = (Eigen::Index)std::floor(texcoord.y() * (Real)image->Height()) % image->Height();
         return (*image)(row, col).head(3);
     }
 };
 
-// struct NormalTexture2D final : Texture2D<Eigen::Vector3d>
+// Tagged Copy Of A Color Texture For Shading. Pure Colors Are Inlined, Others Point Back To Their Texture
+// And Are Sampled By Kind Instead Of Through A Virtual Call.
+struct PackedTexture
+{
+    Vector3r color;                     // Pure Color Only.
+    const Texture2D<Vector3r>* texture; // nullptr For Pure Colors. Owned By The Material.
+
+    NODISCARD static PackedTexture From(const Texture2D<Vector3r>* texture) NOEXCEPT
+    {
+        if (const PureColorTexture2D* pure_color = DynCast<PureColorTexture2D>(texture); pure_color != nullptr)
+        {
+            return PackedTexture{ pure_color->color, nullptr };
+        }
+        return PackedTexture{ Vector3r{ 0.0, 0.0, 0.0 }, texture };
+    }
+
+    NODISCARD FORCE_INLINE Vector3r Sample(const Vector2r& texcoord) const NOEXCEPT
+    {
+        if (texture == nullptr) LIKELY
+        {
+            return color;
+        }
+        if (const CheckerTexture2D* checker = DynCast<CheckerTexture2D>(texture); checker != nullptr)
+        {
+            return checker->CheckerTexture2D::Sample(texcoord);
+        }
+        return Cast<ImageTexture2D>(texture)->ImageTexture2D::Sample(texcoord);
+    }
+};
+
+// struct NormalTexture2D final : Texture2D<Vector3r>
 // {
 //     Ref<Image> image;
 //
@@ -87,10 +137,10 @@ struct ImageTexture2D final : Texture2D<Eigen::Vector3d>
 //     : image(image)
 //     {}
 //
-//     NODISCARD Eigen::Vector3d Sample(const Eigen::Vector2d &texcoord) const NOEXCEPT OVERRIDE
+//     NODISCARD Vector3r Sample(const Vector2r &texcoord) const NOEXCEPT OVERRIDE
 //     {
-//         const Eigen::Index col = (Eigen::Index)std::floor(texcoord.x() * (double)image->Width()) % image->Width();
-//         const Eigen::Index row = (Eigen::Index)std::floor(texcoord.y() * (double)image->Height()) % image->Height();
+//         const Eigen::Index col = (Eigen::Index)std::floor(texcoord.x() * (Real)image->Width()) % image->Width();
+//         const Eigen::Index row = (Eigen::Index)std::floor(texcoord.y() * (Real)image->Height()) % image->Height();
 //         return (*image)(row, col).head(3);
 //     }
 // };
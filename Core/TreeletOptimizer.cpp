@@ -0,0 +1,278 @@
+/**
+  ******************************************************************************
+  * @file           : TreeletOptimizer.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-31
+  ******************************************************************************
+  */
+
+
+
+#include <Core/TreeletOptimizer.h>
+#include <Core/Parallel.h>
+#include <Core/Debug.h>
+
+#include <bit>
+
+namespace
+{
+
+CONSTEXPR int MAX_TREELET_SIZE = 8;
+
+// Traversal Stacks Hold 64 Entries, A Restructure Is Dropped If It Would Push The Tree Deeper.
+CONSTEXPR Eigen::Index MAX_DEPTH = 64;
+
+void UpdateLeaf(BVHBuildNode& node, const BVHConfig& config) NOEXCEPT
+{
+    node.cost = BVHBuilder::SurfaceArea(node.bmin, node.bmax) * config.intersection_cost * (double)node.count;
+    node.height = 1;
+}
+
+// Bounds, Cost And Height From The Children. The Second Child Gets The Larger Center Along axis, As The Builders Do.
+void UpdateInterior(BVHBuildNode& node, const BVHConfig& config) NOEXCEPT
+{
+    const BVHBuildNode& left = *node.children[0];
+    const BVHBuildNode& right = *node.children[1];
+    node.bmin = left.bmin.cwiseMin(right.bmin);
+    node.bmax = left.bmax.cwiseMax(right.bmax);
+    node.cost = BVHBuilder::SurfaceArea(node.bmin, node.bmax) * config.traversal_cost + left.cost + right.cost;
+    node.height = 1 + std::max(left.height, right.height);
+
+    const Eigen::Vector3d d = (right.bmin + right.bmax) - (left.bmin + left.bmax);
+    d.cwiseAbs().maxCoeff(&node.axis);
+    if (d[node.axis] < 0.0)
+    {
+        std::swap(node.children[0], node.children[1]);
+    }
+}
+
+struct Treelet
+{
+    const BVHConfig& config;
+    int n = 0;
+    BVHBuildNode* leaves[MAX_TREELET_SIZE] = {};
+    BVHBuildNode* interiors[MAX_TREELET_SIZE] = {}; // interiors[0] Is The Root.
+    int interior_count = 0;
+
+    // Indexed By Leaf Subset.
+    double cost[1 << MAX_TREELET_SIZE] = {};
+    Eigen::Index height[1 << MAX_TREELET_SIZE] = {};
+    uint8_t part[1 << MAX_TREELET_SIZE] = {}; // Subset Taken By The First Child.
+
+    Uni<BVHBuildNode> owned_leaves[MAX_TREELET_SIZE];
+    Uni<BVHBuildNode> owned_interiors[MAX_TREELET_SIZE];
+    int free_count = 0;
+
+    NODISCARD explicit Treelet(const BVHConfig& config) NOEXCEPT : config(config) {}
+
+    // Expands The Leaf With The Largest Surface Area Until There Are config.treelet_size Leaves.
+    void Form(BVHBuildNode& root) NOEXCEPT
+    {
+        interiors[interior_count++] = &root;
+        leaves[n++] = root.children[0].get();
+        leaves[n++] = root.children[1].get();
+        while (n < config.treelet_size)
+        {
+            int best = -1;
+            double best_area = -INF;
+            for (int i = 0; i < n; ++i)
+            {
+                if (leaves[i]->IsLeaf()) { continue; }
+                const double area = BVHBuilder::SurfaceArea(leaves[i]->bmin, leaves[i]->bmax);
+                if (area > best_area)
+                {
+                    best_area = area;
+                    best = i;
+                }
+            }
+            if (best < 0) { break; }
+
+            BVHBuildNode* expand = leaves[best];
+            interiors[interior_count++] = expand;
+            leaves[best] = expand->children[0].get();
+            leaves[n++] = expand->children[1].get();
+        }
+    }
+
+    // Optimal Cost Of Every Subset. Subsets Of s Are Numerically Smaller, So One Increasing Sweep Suffices.
+    void Solve() NOEXCEPT
+    {
+        Eigen::Vector3d bmin[1 << MAX_TREELET_SIZE];
+        Eigen::Vector3d bmax[1 << MAX_TREELET_SIZE];
+        for (uint32_t s = 1; s < (1u << n); ++s)
+        {
+            const uint32_t lowest = s & (0u - s);
+            const BVHBuildNode& leaf = *leaves[std::countr_zero(lowest)];
+            if (s == lowest)
+            {
+                bmin[s] = leaf.bmin;
+                bmax[s] = leaf.bmax;
+                cost[s] = leaf.cost;
+                height[s] = leaf.height;
+                continue;
+            }
+            bmin[s] = bmin[s ^ lowest].cwiseMin(leaf.bmin);
+            bmax[s] = bmax[s ^ lowest].cwiseMax(leaf.bmax);
+
+            // The First Child Always Takes The Lowest Leaf, Which Visits Each Partition Once.
+            const uint32_t rest = s ^ lowest;
+            double best = INF;
+            for (uint32_t p = rest;; p = (p - 1) & rest)
+            {
+                const uint32_t left = p | lowest;
+                if (left != s && cost[left] + cost[s ^ left] < best)
+                {
+                    best = cost[left] + cost[s ^ left];
+                    part[s] = (uint8_t)left;
+                }
+                if (p == 0) { break; }
+            }
+            cost[s] = BVHBuilder::SurfaceArea(bmin[s], bmax[s]) * config.traversal_cost + best;
+            height[s] = 1 + std::max(height[part[s]], height[s ^ part[s]]);
+        }
+    }
+
+    NODISCARD Uni<BVHBuildNode> Take(const uint32_t s) NOEXCEPT // NOLINT(*-no-recursion)
+    {
+        if (std::has_single_bit(s))
+        {
+            return std::move(owned_leaves[std::countr_zero(s)]);
+        }
+        Uni<BVHBuildNode> node = std::move(owned_interiors[--free_count]);
+        Link(*node, s);
+        return node;
+    }
+
+    void Link(BVHBuildNode& node, const uint32_t s) NOEXCEPT // NOLINT(*-no-recursion)
+    {
+        node.children[0] = Take(part[s]);
+        node.children[1] = Take(s ^ part[s]);
+        UpdateInterior(node, config);
+    }
+
+    // Detaches Every Node Below The Root, Then Links Them Again In The Optimal Shape.
+    void Rebuild() NOEXCEPT
+    {
+        for (int i = 0; i < interior_count; ++i)
+        {
+            for (Uni<BVHBuildNode>& child : interiors[i]->children)
+            {
+                const int leaf = (int)(std::find(leaves, leaves + n, child.get()) - leaves);
+                if (leaf < n)
+                {
+                    owned_leaves[leaf] = std::move(child);
+                }
+                else
+                {
+                    owned_interiors[free_count++] = std::move(child);
+                }
+            }
+        }
+        ASSERT(free_count == n - 2);
+        Link(*interiors[0], (1u << n) - 1);
+    }
+};
+
+void Restructure(BVHBuildNode& root, const BVHConfig& config, const Eigen::Index depth) NOEXCEPT
+{
+    Treelet treelet(config);
+    treelet.Form(root);
+    if (treelet.n < 3) { return; }
+
+    treelet.Solve();
+    const uint32_t all = (1u << treelet.n) - 1;
+    if (treelet.cost[all] >= root.cost * (1.0 - 1e-9) || depth - 1 + treelet.height[all] > MAX_DEPTH) { return; }
+
+    treelet.Rebuild();
+}
+
+// Post Order. Nodes At cut_depth Were Optimized By A Task Already.
+void OptimizeRecursive(BVHBuildNode& node, const BVHConfig& config, const Eigen::Index depth, const Eigen::Index cut_depth) NOEXCEPT // NOLINT(*-no-recursion)
+{
+    if (node.IsLeaf())
+    {
+        UpdateLeaf(node, config);
+        return;
+    }
+    if (depth == cut_depth) { return; }
+
+    OptimizeRecursive(*node.children[0], config, depth + 1, cut_depth);
+    OptimizeRecursive(*node.children[1], config, depth + 1, cut_depth);
+    UpdateInterior(node, config);
+    Restructure(node, config, depth);
+}
+
+}
+
+void TreeletOptimizer::Optimize(BVHBuilder::Result& result, const BVHConfig& config) NOEXCEPT
+{
+    ASSERT(2 <= config.treelet_size && config.treelet_size <= MAX_TREELET_SIZE);
+
+    if (result.root == nullptr) UNLIKELY
+    {
+        return;
+    }
+
+    const auto st = Debug::Now();
+
+    struct Task
+    {
+        BVHBuildNode* node;
+        Eigen::Index depth;
+    };
+
+    for (Eigen::Index pass = 0; pass < config.treelet_passes; ++pass)
+    {
+        // Subtrees At cut_depth Are Independent Tasks, The Few Nodes Above Are Done On This Thread Afterwards.
+        // Restructuring Moves Nodes Across That Level, So It Is Chosen Again For Every Pass.
+        std::vector<Task> tasks;
+        Eigen::Index cut_depth = -1;
+        if (THREAD_POOL.ThreadNumber() > 1)
+        {
+            std::vector<Task> level = { Task{ result.root.get(), 1 } };
+            while (!level.empty() && level.size() < 8 * (size_t)THREAD_POOL.ThreadNumber())
+            {
+                std::vector<Task> next;
+                for (const Task& task : level)
+                {
+                    if (task.node->IsLeaf()) { continue; }
+                    next.push_back(Task{ task.node->children[0].get(), task.depth + 1 });
+                    next.push_back(Task{ task.node->children[1].get(), task.depth + 1 });
+                }
+                level = std::move(next);
+            }
+            for (const Task& task : level)
+            {
+                if (!task.node->IsLeaf()) { tasks.push_back(task); }
+            }
+            if (!tasks.empty()) { cut_depth = tasks.front().depth; }
+        }
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasks.size());
+        for (const Task& task : tasks)
+        {
+            futures.push_back(THREAD_POOL.Submit([&config, task]() -> void
+            {
+                OptimizeRecursive(*task.node, config, task.depth, -1);
+            }));
+        }
+        for (auto& future : futures)
+        {
+            future.wait();
+        }
+        OptimizeRecursive(*result.root, config, 1, cut_depth);
+    }
+
+    const BVHStatistics built = result.statistics;
+    result.statistics = BVHBuilder::Statistics(*result.root, config);
+    result.statistics.primitive_count = built.primitive_count;
+    result.statistics.reference_count = built.reference_count;
+    result.statistics.build_time = built.build_time;
+    result.statistics.unoptimized_sah_cost = built.sah_cost;
+
+    const auto ed = Debug::Now();
+    result.statistics.optimize_time = Debug::MicroSeconds(ed - st);
+}
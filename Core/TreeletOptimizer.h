@@ -0,0 +1,28 @@
+/**
+  ******************************************************************************
+  * @file           : TreeletOptimizer.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-31
+  ******************************************************************************
+  */
+
+
+
+#ifndef TREELET_OPTIMIZER_H
+#define TREELET_OPTIMIZER_H
+
+#include <Core/Common.h>
+#include <Core/BVHBuilder.h>
+
+// Treelet Restructuring. Ref: https://research.nvidia.com/publication/2013-07_fast-parallel-construction-high-quality-bounding-volume-hierarchies
+// Bottom Up, Every Interior Node Grows A Treelet Of config.treelet_size Leaves And Rebuilds It In The SAH Optimal Shape.
+// Leaves Keep Their Primitive Ranges, So result.order Stays Valid And Any Builder's Output Can Be Optimized.
+struct TreeletOptimizer
+{
+    // Updates result.statistics, Including unoptimized_sah_cost And optimize_time.
+    static void Optimize(BVHBuilder::Result& result, const BVHConfig& config) NOEXCEPT;
+};
+
+#endif //TREELET_OPTIMIZER_H
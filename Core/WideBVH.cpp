@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file           : WideBVH.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-24
+  ******************************************************************************
+  */
+
+
+
+#include <Core/WideBVH.h>
+#include <Core/Parallel.h>
+
+namespace
+{
+
+template<int WIDTH>
+uint32_t Collapse(std::vector<WideBVHNode<WIDTH>>& nodes, const BVHBuildNode& build_node) NOEXCEPT // NOLINT(*-no-recursion)
+{
+    const uint32_t node_index = (uint32_t)nodes.size();
+    nodes.emplace_back();
+
+    const BVHBuildNode* children[WIDTH];
+    int n = 0;
+    if (build_node.IsLeaf())
+    {
+        children[n++] = &build_node;
+    }
+    else
+    {
+        children[n++] = build_node.children[0].get();
+        children[n++] = build_node.children[1].get();
+    }
+
+    while (n < WIDTH)
+    {
+        int best = -1;
+        double best_area = -INF;
+        for (int i = 0; i < n; ++i)
+        {
+            if (children[i]->IsLeaf()) { continue; }
+            const double area = BVHBuilder::SurfaceArea(children[i]->bmin, children[i]->bmax);
+            if (area > best_area)
+            {
+                best_area = area;
+                best = i;
+            }
+        }
+        if (best < 0) { break; }
+
+        const BVHBuildNode* expand = children[best];
+        children[best] = expand->children[0].get();
+        children[n++] = expand->children[1].get();
+    }
+
+    WideBVHNode<WIDTH> node;
+    for (int lane = 0; lane < WIDTH; ++lane)
+    {
+        for (int a = 0; a < 3; ++a)
+        {
+            node.bmin[a][lane] = std::numeric_limits<float>::infinity();
+            node.bmax[a][lane] = -std::numeric_limits<float>::infinity();
+        }
+        node.child[lane] = 0;
+        node.count[lane] = 0;
+    }
+
+    for (int lane = 0; lane < n; ++lane)
+    {
+        const BVHBuildNode& child = *children[lane];
+        for (int a = 0; a < 3; ++a)
+        {
+            node.bmin[a][lane] = FRoundDown(child.bmin[a]);
+            node.bmax[a][lane] = FRoundUp(child.bmax[a]);
+        }
+        if (child.IsLeaf())
+        {
+            ASSERT(child.count <= std::numeric_limits<uint16_t>::max());
+            node.child[lane] = (uint32_t)child.begin;
+            node.count[lane] = (uint16_t)child.count;
+        }
+        else
+        {
+            node.child[lane] = Collapse(nodes, child);
+        }
+    }
+
+    nodes[node_index] = node;
+    return node_index;
+}
+
+}
+
+template<int WIDTH>
+NODISCARD WideBVH<WIDTH> WideBVH<WIDTH>::From(const BVHBuildNode& root) NOEXCEPT
+{
+    std::vector<WideBVHNode<WIDTH>> t_nodes;
+    Collapse(t_nodes, root);
+    WideBVH bvh;
+    bvh.nodes = std::move(t_nodes);
+    return bvh;
+}
+
+template<int WIDTH>
+void WideBVH<WIDTH>::Refit(const std::vector<BVHBuilder::Primitive>& primitives) NOEXCEPT
+{
+    Parallel::For(0, nodes.size(), THREAD_POOL.ThreadNumber(),
+        [this, &primitives](size_t thread_begin, size_t thread_end)
+        {
+            for (size_t i = thread_begin; i < thread_end; ++i)
+            {
+                WideBVHNode<WIDTH>& node = nodes[i];
+                for (int lane = 0; lane < WIDTH; ++lane)
+                {
+                    if (node.count[lane] == 0) { continue; }
+                    Eigen::Vector3d t_bmin, t_bmax;
+                    BVHBuilder::RangeBounds(primitives, node.child[lane], node.child[lane] + node.count[lane], t_bmin, t_bmax);
+                    for (int a = 0; a < 3; ++a)
+                    {
+                        node.bmin[a][lane] = FRoundDown(t_bmin[a]);
+                        node.bmax[a][lane] = FRoundUp(t_bmax[a]);
+                    }
+                }
+            }
+        }
+    );
+
+    // Children Always Follow Their Parent, Only The Root Has Index Zero So child == 0 Marks An Unused Slot.
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        WideBVHNode<WIDTH>& node = nodes[i];
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            if (node.count[lane] != 0 || node.child[lane] == 0) { continue; }
+            const WideBVHNode<WIDTH>& child = nodes[node.child[lane]];
+            for (int a = 0; a < 3; ++a)
+            {
+                node.bmin[a][lane] = *std::min_element(child.bmin[a], child.bmin[a] + WIDTH);
+                node.bmax[a][lane] = *std::max_element(child.bmax[a], child.bmax[a] + WIDTH);
+            }
+        }
+    }
+}
+
+template<int WIDTH>
+NODISCARD double WideBVH<WIDTH>::Cost(const BVHConfig& config) const NOEXCEPT
+{
+    if (nodes.empty()) UNLIKELY
+    {
+        return 0.0;
+    }
+
+    Eigen::Vector3d root_bmin = Eigen::Vector3d::Constant(INF);
+    Eigen::Vector3d root_bmax = Eigen::Vector3d::Constant(-INF);
+    for (int a = 0; a < 3; ++a)
+    {
+        root_bmin[a] = *std::min_element(nodes[0].bmin[a], nodes[0].bmin[a] + WIDTH);
+        root_bmax[a] = *std::max_element(nodes[0].bmax[a], nodes[0].bmax[a] + WIDTH);
+    }
+    const double root_area = BVHBuilder::SurfaceArea(root_bmin, root_bmax);
+    if (root_area <= 0.0) UNLIKELY
+    {
+        return 0.0;
+    }
+
+    // The Root Is Always Visited, Every Other Node Is Charged Through Its Slot In The Parent.
+    double sah_cost = root_area * config.traversal_cost;
+    for (const WideBVHNode<WIDTH>& node : nodes)
+    {
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            if (node.count[lane] == 0 && node.child[lane] == 0) { continue; }
+            const double area = BVHBuilder::SurfaceArea(
+                Eigen::Vector3d{ node.bmin[0][lane], node.bmin[1][lane], node.bmin[2][lane] },
+                Eigen::Vector3d{ node.bmax[0][lane], node.bmax[1][lane], node.bmax[2][lane] });
+            sah_cost += area * (node.count[lane] > 0 ? config.intersection_cost * (double)node.count[lane] : config.traversal_cost);
+        }
+    }
+    return sah_cost / root_area;
+}
+
+template struct WideBVH<4>;
+template struct WideBVH<8>;
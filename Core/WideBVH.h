@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file           : WideBVH.h
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-24
+  ******************************************************************************
+  */
+
+
+
+#ifndef WIDE_BVH_H
+#define WIDE_BVH_H
+
+#include <Core/Common.h>
+#include <Core/Ray.h>
+#include <Core/Interval.h>
+#include <Core/BVHBuilder.h>
+#include <Core/Buffer.h>
+
+#include <bit>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#endif
+
+// Children Stored As SoA So One Slab Test Covers All Of Them. Unused Slots Have Inverted Bounds And Never Hit.
+template<int WIDTH>
+struct alignas(64) WideBVHNode
+{
+    static_assert(WIDTH == 4 || WIDTH == 8);
+
+    float bmin[3][WIDTH];
+    float bmax[3][WIDTH];
+    uint32_t child[WIDTH]; // Interior Child: Node Index. Leaf Child: First Primitive.
+    uint16_t count[WIDTH]; // Leaf Child: Number Of Primitives. Zero For Interior Child.
+};
+
+// Stack Traversal Shared By The Wide Layouts. Nodes Need child[WIDTH] And count[WIDTH], Unused Slots Must Never Hit.
+// HitNode: uint32_t(const NODE& node, ray, interval, t_entry), See WideBVH::Hit.
+// HitPrimitive: bool(Eigen::Index index, Interval& interval). Shrinks interval.imax On A Closer Hit.
+// ANY_HIT: Stop At The First Primitive Hit, For Occlusion Queries.
+template<int WIDTH, bool ANY_HIT, typename NODE, typename HitNode, typename HitPrimitive>
+NODISCARD bool WideTraverse(const Buffer<NODE>& nodes, const Ray& ray, const Interval& interval, HitNode&& hit_node, HitPrimitive&& hit_primitive) NOEXCEPT
+{
+    // Each Visited Node Pushes At Most WIDTH Entries And Pops One, The Binary Depth Is At Most 64.
+    CONSTEXPR Eigen::Index MAX_STACK_SIZE = 64 * (WIDTH - 1) + 1;
+
+    if (nodes.empty()) UNLIKELY
+    {
+        return false;
+    }
+
+    struct StackEntry
+    {
+        uint32_t index; // Node Index, Or First Primitive If count > 0.
+        uint32_t count;
+        Real t_entry;
+    };
+
+    StackEntry stack[MAX_STACK_SIZE];
+    Eigen::Index top = 0;
+    stack[top++] = StackEntry{ 0, 0, interval.imin };
+
+    Interval t_interval = interval;
+    bool hit = false;
+
+    while (top > 0)
+    {
+        const StackEntry entry = stack[--top];
+
+        // Skip Entries That Start Behind The Closest Hit So Far.
+        if (entry.t_entry > t_interval.imax) { continue; }
+
+        if (entry.count > 0)
+        {
+            for (uint32_t i = entry.index; i < entry.index + entry.count; ++i)
+            {
+                if (!hit_primitive((Eigen::Index)i, t_interval)) { continue; }
+                if CONSTEXPR (ANY_HIT) { return true; }
+                hit = true;
+            }
+            continue;
+        }
+
+        const NODE& node = nodes[entry.index];
+        alignas(32) Real t_entry[WIDTH];
+        uint32_t mask = hit_node(node, ray, t_interval, t_entry);
+
+        // Push Far To Near So That The Nearest Child Is Popped First.
+        int order[WIDTH];
+        int n = 0;
+        while (mask != 0)
+        {
+            const int lane = std::countr_zero(mask);
+            mask &= mask - 1;
+            int i = n++;
+            for (; i > 0 && t_entry[order[i - 1]] < t_entry[lane]; --i) { order[i] = order[i - 1]; }
+            order[i] = lane;
+        }
+
+        ASSERT(top + n <= MAX_STACK_SIZE);
+        for (int i = 0; i < n; ++i)
+        {
+            const int lane = order[i];
+            stack[top++] = StackEntry{ node.child[lane], node.count[lane], t_entry[lane] };
+        }
+    }
+
+    return hit;
+}
+
+template<int WIDTH>
+struct WideBVH
+{
+    Buffer<WideBVHNode<WIDTH>> nodes;
+
+    // Collapses The Binary Build Tree, Pulling Up The Interior Child With The Largest Surface Area Until WIDTH Children.
+    NODISCARD static WideBVH From(const BVHBuildNode& root) NOEXCEPT;
+
+    // Recomputes Bounds Bottom Up. Leaf Slot i Must Describe The i-th Primitive In Build Order.
+    void Refit(const std::vector<BVHBuilder::Primitive>& primitives) NOEXCEPT;
+
+    NODISCARD double Cost(const BVHConfig& config) const NOEXCEPT;
+
+    // Writes The Entry Distance Of Every Child, Returns A Bit Mask Of The Children Hit.
+    NODISCARD FORCE_INLINE static uint32_t Hit(const WideBVHNode<WIDTH>& node, const Ray& ray, const Interval& interval, Real t_entry[WIDTH]) NOEXCEPT
+    {
+        uint32_t mask = 0;
+        #if defined(__AVX__) && defined(REAL_FLOAT)
+        // Bounds Are Used As Stored, All Children Of A WIDTH 8 Node Fit One Register. max(t, t0) Drops NaN From 0 * INF.
+        if CONSTEXPR (WIDTH == 8)
+        {
+            __m256 t0 = _mm256_set1_ps(interval.imin);
+            __m256 t1 = _mm256_set1_ps(interval.imax);
+            for (int a = 0; a < 3; ++a)
+            {
+                const __m256 lo = _mm256_load_ps(node.bmin[a]);
+                const __m256 hi = _mm256_load_ps(node.bmax[a]);
+                const __m256 o = _mm256_set1_ps(ray.origin[a]);
+                const __m256 inv = _mm256_set1_ps(ray.inv_direction[a]);
+                const __m256 t_near = _mm256_mul_ps(_mm256_sub_ps(ray.sign[a] ? hi : lo, o), inv);
+                const __m256 t_far = _mm256_mul_ps(_mm256_sub_ps(ray.sign[a] ? lo : hi, o), inv);
+                t0 = _mm256_max_ps(t_near, t0);
+                t1 = _mm256_min_ps(t_far, t1);
+            }
+            _mm256_store_ps(t_entry, t0);
+            mask = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(t0, t1, _CMP_LE_OQ));
+        }
+        else
+        {
+            __m128 t0 = _mm_set1_ps(interval.imin);
+            __m128 t1 = _mm_set1_ps(interval.imax);
+            for (int a = 0; a < 3; ++a)
+            {
+                const __m128 lo = _mm_load_ps(node.bmin[a]);
+                const __m128 hi = _mm_load_ps(node.bmax[a]);
+                const __m128 o = _mm_set1_ps(ray.origin[a]);
+                const __m128 inv = _mm_set1_ps(ray.inv_direction[a]);
+                const __m128 t_near = _mm_mul_ps(_mm_sub_ps(ray.sign[a] ? hi : lo, o), inv);
+                const __m128 t_far = _mm_mul_ps(_mm_sub_ps(ray.sign[a] ? lo : hi, o), inv);
+                t0 = _mm_max_ps(t_near, t0);
+                t1 = _mm_min_ps(t_far, t1);
+            }
+            _mm_store_ps(t_entry, t0);
+            mask = (uint32_t)_mm_movemask_ps(_mm_cmp_ps(t0, t1, _CMP_LE_OQ));
+        }
+        #elif defined(__AVX__)
+        // Bounds Are Widened To Double, Results Match The Scalar Slab Test Exactly. max(t, t0) Drops NaN From 0 * INF.
+        for (int lane = 0; lane < WIDTH; lane += 4)
+        {
+            __m256d t0 = _mm256_set1_pd(interval.imin);
+            __m256d t1 = _mm256_set1_pd(interval.imax);
+            for (int a = 0; a < 3; ++a)
+            {
+                const __m256d lo = _mm256_cvtps_pd(_mm_load_ps(node.bmin[a] + lane));
+                const __m256d hi = _mm256_cvtps_pd(_mm_load_ps(node.bmax[a] + lane));
+                const __m256d o = _mm256_set1_pd(ray.origin[a]);
+                const __m256d inv = _mm256_set1_pd(ray.inv_direction[a]);
+                const __m256d t_near = _mm256_mul_pd(_mm256_sub_pd(ray.sign[a] ? hi : lo, o), inv);
+                const __m256d t_far = _mm256_mul_pd(_mm256_sub_pd(ray.sign[a] ? lo : hi, o), inv);
+                t0 = _mm256_max_pd(t_near, t0);
+                t1 = _mm256_min_pd(t_far, t1);
+            }
+            _mm256_storeu_pd(t_entry + lane, t0);
+            mask |= (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(t0, t1, _CMP_LE_OQ)) << lane;
+        }
+        #else
+        for (int lane = 0; lane < WIDTH; ++lane)
+        {
+            Real t0 = interval.imin, t1 = interval.imax;
+            for (int a = 0; a < 3; ++a)
+            {
+                const Real t_near = ((Real)(ray.sign[a] ? node.bmax[a][lane] : node.bmin[a][lane]) - ray.origin[a]) * ray.inv_direction[a];
+                const Real t_far = ((Real)(ray.sign[a] ? node.bmin[a][lane] : node.bmax[a][lane]) - ray.origin[a]) * ray.inv_direction[a];
+                t0 = std::max(t0, t_near);
+                t1 = std::min(t1, t_far);
+            }
+            t_entry[lane] = t0;
+            mask |= (uint32_t)(t0 <= t1) << lane;
+        }
+        #endif
+        return mask;
+    }
+
+    // HitPrimitive: bool(Eigen::Index index, Interval& interval). Shrinks interval.imax On A Closer Hit.
+    // ANY_HIT: Stop At The First Primitive Hit, For Occlusion Queries.
+    template<bool ANY_HIT = false, typename HitPrimitive>
+    NODISCARD FORCE_INLINE bool Traverse(const Ray& ray, const Interval& interval, HitPrimitive&& hit_primitive) const NOEXCEPT
+    {
+        return WideTraverse<WIDTH, ANY_HIT>(nodes, ray, interval,
+            [](const WideBVHNode<WIDTH>& node, const Ray& ray, const Interval& t_interval, Real t_entry[WIDTH]) -> uint32_t
+            {
+                return Hit(node, ray, t_interval, t_entry);
+            },
+            std::forward<HitPrimitive>(hit_primitive));
+    }
+};
+
+#endif //WIDE_BVH_H
@@ -0,0 +1,227 @@
+/**
+  ******************************************************************************
+  * @file           : TestBVH.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-3-27
+  ******************************************************************************
+  */
+
+#include <doctest/doctest.h>
+
+#include <Core/Debug.h>
+#include <Core/LinearBVH.h>
+
+namespace
+{
+
+struct Soup
+{
+    std::vector<Eigen::Vector3d> vertices; // Three Per Triangle.
+
+    NODISCARD Eigen::Index Size() const NOEXCEPT { return (Eigen::Index)vertices.size() / 3; }
+
+    NODISCARD bool Intersect(const Eigen::Index index, const Ray& ray, const Interval& interval, double& t) const NOEXCEPT
+    {
+        const Eigen::Vector3d& v0 = vertices[3 * index + 0];
+        const Eigen::Vector3d v1v0 = vertices[3 * index + 1] - v0;
+        const Eigen::Vector3d v2v0 = vertices[3 * index + 2] - v0;
+        const Eigen::Vector3d rov0 = ray.origin - v0;
+        const Eigen::Vector3d n = v1v0.cross(v2v0);
+        const double rdn = ray.direction.dot(n);
+        if (FIsZero(rdn)) { return false; }
+        const Eigen::Vector3d q = rov0.cross(ray.direction);
+        const double d = 1.0 / rdn;
+        const double u = d * -q.dot(v2v0);
+        const double v = d * q.dot(v1v0);
+        t = d * -n.dot(rov0);
+        return interval.Contain(t) && !(FIsNegative(u) || FIsNegative(v) || Fgt(u + v, 1.0));
+    }
+};
+
+// Long Thin Triangles Across The Scene (Walls, Beams) Mixed With Small Clutter.
+Soup MakeArchitecturalSoup(std::mt19937& gen) NOEXCEPT
+{
+    std::uniform_real_distribution<double> position(-10.0, 10.0);
+    std::uniform_real_distribution<double> offset(-0.3, 0.3);
+
+    Soup soup;
+    for (int i = 0; i < 500; ++i)
+    {
+        const Eigen::Vector3d a{ position(gen), position(gen), position(gen) };
+        const Eigen::Vector3d b{ position(gen), position(gen), position(gen) };
+        soup.vertices.insert(soup.vertices.end(), { a, b, a + 0.2 * Eigen::Vector3d{ offset(gen), offset(gen), offset(gen) } });
+    }
+    for (int i = 0; i < 2500; ++i)
+    {
+        const Eigen::Vector3d c{ position(gen), position(gen), position(gen) };
+        for (int k = 0; k < 3; ++k)
+        {
+            soup.vertices.push_back(c + Eigen::Vector3d{ offset(gen), offset(gen), offset(gen) });
+        }
+    }
+    return soup;
+}
+
+void ClipTriangle(const Soup& soup, const BVHBuilder::Primitive& reference, const Eigen::Index axis, const double position, BVHBuilder::Primitive& left, BVHBuilder::Primitive& right) NOEXCEPT
+{
+    left.bmin = right.bmin = Eigen::Vector3d::Constant(INF);
+    left.bmax = right.bmax = Eigen::Vector3d::Constant(-INF);
+    for (int i = 0; i < 3; ++i)
+    {
+        const Eigen::Vector3d& v0 = soup.vertices[3 * reference.index + i];
+        const Eigen::Vector3d& v1 = soup.vertices[3 * reference.index + (i + 1) % 3];
+        if (v0[axis] <= position) { left.bmin = left.bmin.cwiseMin(v0); left.bmax = left.bmax.cwiseMax(v0); }
+        if (v0[axis] >= position) { right.bmin = right.bmin.cwiseMin(v0); right.bmax = right.bmax.cwiseMax(v0); }
+        if ((v0[axis] < position && position < v1[axis]) || (v1[axis] < position && position < v0[axis]))
+        {
+            Eigen::Vector3d p = v0 + (position - v0[axis]) / (v1[axis] - v0[axis]) * (v1 - v0);
+            p[axis] = position;
+            left.bmin = left.bmin.cwiseMin(p); left.bmax = left.bmax.cwiseMax(p);
+            right.bmin = right.bmin.cwiseMin(p); right.bmax = right.bmax.cwiseMax(p);
+        }
+    }
+}
+
+std::vector<Ray> MakeRays(std::mt19937& gen) NOEXCEPT
+{
+    std::uniform_real_distribution<double> position(-10.0, 10.0);
+    std::uniform_real_distribution<double> direction(-1.0, 1.0);
+    std::vector<Ray> rays;
+    for (int i = 0; i < 1000; ++i)
+    {
+        rays.emplace_back(Eigen::Vector3d{ position(gen), position(gen), position(gen) }, Eigen::Vector3d{ direction(gen), direction(gen), direction(gen) }.normalized());
+    }
+    return rays;
+}
+
+// Brute Force Reference.
+std::vector<double> ClosestHits(const Soup& soup, const std::vector<Ray>& rays) NOEXCEPT
+{
+    std::vector<double> expected(rays.size(), INF);
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        Interval interval{ EPS, INF };
+        for (Eigen::Index i = 0; i < soup.Size(); ++i)
+        {
+            if (double t; soup.Intersect(i, rays[r], interval, t)) { interval.imax = expected[r] = t; }
+        }
+    }
+    return expected;
+}
+
+LinearBVH Build(const Soup& soup, const BVHConfig& config, std::vector<Eigen::Index>& order) NOEXCEPT
+{
+    std::vector<BVHBuilder::Primitive> primitives((size_t)soup.Size());
+    for (Eigen::Index i = 0; i < soup.Size(); ++i)
+    {
+        const Eigen::Vector3d& a = soup.vertices[3 * i + 0];
+        const Eigen::Vector3d& b = soup.vertices[3 * i + 1];
+        const Eigen::Vector3d& c = soup.vertices[3 * i + 2];
+        primitives[i] = BVHBuilder::Primitive{ a.cwiseMin(b).cwiseMin(c), a.cwiseMax(b).cwiseMax(c), (a + b + c) / 3.0, i };
+    }
+
+    return LinearBVH::Build(primitives, config, order,
+        [&soup](const BVHBuilder::Primitive& reference, const Eigen::Index axis, const double position, BVHBuilder::Primitive& left, BVHBuilder::Primitive& right)
+        {
+            ClipTriangle(soup, reference, axis, position, left, right);
+        }
+    );
+}
+
+Eigen::Index CountMismatches(const Soup& soup, const LinearBVH& bvh, const std::vector<Eigen::Index>& order, const std::vector<Ray>& rays, const std::vector<double>& expected) NOEXCEPT
+{
+    Eigen::Index mismatch = 0;
+    for (size_t r = 0; r < rays.size(); ++r)
+    {
+        double closest = INF;
+        Debug::Unuse(bvh.Traverse(rays[r], Interval{ EPS, INF }, [&soup, &order, &closest, &ray = rays[r]](const Eigen::Index index, Interval& interval) -> bool
+        {
+            double t;
+            if (!soup.Intersect(order[index], ray, interval, t)) { return false; }
+            interval.imax = closest = t;
+            return true;
+        }));
+        mismatch += closest != expected[r];
+    }
+    return mismatch;
+}
+
+}
+
+TEST_CASE("SBVH")
+{
+    std::mt19937 gen(42);
+    const Soup soup = MakeArchitecturalSoup(gen);
+    const std::vector<Ray> rays = MakeRays(gen);
+    const std::vector<double> expected = ClosestHits(soup, rays);
+
+    double object_sah = 0.0, spatial_sah = 0.0;
+    for (const bool spatial_splits : { false, true })
+    {
+        for (const auto layout : { BVHConfig::BVH_LAYOUT_BINARY, BVHConfig::BVH_LAYOUT_WIDE4, BVHConfig::BVH_LAYOUT_WIDE8, BVHConfig::BVH_LAYOUT_QUANTIZED8, BVHConfig::BVH_LAYOUT_QUANTIZED16 })
+        {
+            BVHConfig config;
+            config.layout = layout;
+            config.spatial_splits = spatial_splits;
+            std::vector<Eigen::Index> order;
+            const LinearBVH bvh = Build(soup, config, order);
+            REQUIRE(order.size() == (size_t)soup.Size());
+
+            const auto st = Debug::Now();
+            const Eigen::Index mismatch = CountMismatches(soup, bvh, order, rays, expected);
+            const auto ed = Debug::Now();
+            CHECK(mismatch == 0);
+
+            const BVHStatistics& statistics = bvh.statistics;
+            (spatial_splits ? spatial_sah : object_sah) = statistics.sah_cost;
+            CHECK(statistics.reference_count <= (Eigen::Index)((1.0 + config.spatial_split_budget) * (double)statistics.primitive_count));
+            Debug::Print("{} Layout {} References {}/{} SAH Cost {:.2f} BVH {:.1f} Bytes/Triangle Build {} us Trace {} ns/ray",
+                spatial_splits ? "Spatial" : "Object ", (int)layout, statistics.reference_count, statistics.primitive_count,
+                statistics.sah_cost, (double)bvh.MemoryUsage() / (double)statistics.primitive_count, statistics.build_time, Debug::NanoSeconds(ed - st) / rays.size());
+        }
+    }
+
+    CHECK(spatial_sah < object_sah);
+}
+
+TEST_CASE("Treelet")
+{
+    std::mt19937 gen(7);
+    const Soup soup = MakeArchitecturalSoup(gen);
+    const std::vector<Ray> rays = MakeRays(gen);
+    const std::vector<double> expected = ClosestHits(soup, rays);
+
+    for (const bool spatial_splits : { false, true })
+    {
+        BVHConfig config;
+        config.spatial_splits = spatial_splits;
+        config.treelet_optimization = true;
+        std::vector<Eigen::Index> order;
+        const LinearBVH bvh = Build(soup, config, order);
+
+        CHECK(CountMismatches(soup, bvh, order, rays, expected) == 0);
+
+        const BVHStatistics& statistics = bvh.statistics;
+        CHECK(statistics.sah_cost < statistics.unoptimized_sah_cost);
+        CHECK(statistics.max_depth <= LinearBVH::MAX_STACK_SIZE);
+        Debug::Print("{} SAH Cost {:.2f} -> {:.2f} Build {} us Optimize {} us",
+            spatial_splits ? "Spatial" : "Object ", statistics.unoptimized_sah_cost, statistics.sah_cost, statistics.build_time, statistics.optimize_time);
+    }
+}
+
+TEST_CASE("Slab")
+{
+    const AABB box(Eigen::Vector3d{ 0.0, 0.0, 0.0 }, Eigen::Vector3d{ 1.0, 1.0, 1.0 });
+    const Interval interval{ EPS, INF };
+
+    // Zero Direction Components, Inside, Outside And On The Slab Planes.
+    CHECK(box.Hit(Ray(Eigen::Vector3d{ 0.5, 0.5, -1.0 }, Eigen::Vector3d{ 0.0, 0.0, 1.0 }), interval));
+    CHECK(box.Hit(Ray(Eigen::Vector3d{ 0.5, 0.5, 2.0 }, Eigen::Vector3d{ -0.0, 0.0, -1.0 }), interval));
+    CHECK(box.Hit(Ray(Eigen::Vector3d{ 0.0, 1.0, -1.0 }, Eigen::Vector3d{ 0.0, -0.0, 1.0 }), interval));
+    CHECK_FALSE(box.Hit(Ray(Eigen::Vector3d{ 2.0, 0.5, -1.0 }, Eigen::Vector3d{ 0.0, 0.0, 1.0 }), interval));
+    CHECK_FALSE(box.Hit(Ray(Eigen::Vector3d{ 0.5, -0.5, -1.0 }, Eigen::Vector3d{ -0.0, -0.0, 1.0 }), interval));
+    CHECK_FALSE(box.Hit(Ray(Eigen::Vector3d{ 0.5, 0.5, -1.0 }, Eigen::Vector3d{ 0.0, 0.0, -1.0 }), interval));
+    CHECK_FALSE(box.Hit(Ray(Eigen::Vector3d{ 0.5, 0.5, -1.0 }, Eigen::Vector3d{ 0.0, 0.0, 1.0 }), Interval{ EPS, 0.5 }));
+}
@@ -0,0 +1,127 @@
+/**
+  ******************************************************************************
+  * @file           : TestLight.cpp
+  * @author         : AliceRemake
+  * @brief          : None
+  * @attention      : None
+  * @date           : 25-4-8
+  ******************************************************************************
+  */
+
+#include <doctest/doctest.h>
+
+#include <Core/Light.h>
+#include <Core/Material.h>
+#include <Core/Primitive.h>
+
+namespace
+{
+
+NODISCARD Eigen::Vector3d RandomDirection(std::mt19937& gen) NOEXCEPT
+{
+    std::normal_distribution<double> normal(0.0, 1.0);
+    return Eigen::Vector3d{ normal(gen), normal(gen), normal(gen) }.normalized();
+}
+
+}
+
+TEST_CASE("Light")
+{
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> position(-5.0, 5.0);
+
+    // LightTree::Sample Picks Each Emitter As Often As LightTree::PMF Claims, Mixing One And Two Sided Bounds.
+    {
+        std::vector<LightBounds> bounds(64);
+        for (size_t i = 0; i < bounds.size(); ++i)
+        {
+            const Eigen::Vector3d corner{ position(gen), position(gen), position(gen) };
+            bounds[i] = LightBounds{ AABB(corner, corner + 0.3 * Eigen::Vector3d{ unit(gen), unit(gen), unit(gen) }), RandomDirection(gen), 1.0, 0.0, 0.1 + 5.0 * unit(gen), i % 2 == 0 };
+        }
+        LightTree tree;
+        tree.Build(bounds);
+        REQUIRE(!tree.IsEmpty());
+
+        for (int query = 0; query < 4; ++query)
+        {
+            const Eigen::Vector3d point{ position(gen), position(gen), position(gen) };
+            const Eigen::Vector3d normal = RandomDirection(gen);
+
+            CONSTEXPR int samples = 200000;
+            std::vector<int> counts(bounds.size(), 0);
+            int failures = 0;
+            for (int i = 0; i < samples; ++i)
+            {
+                uint32_t emitter;
+                double pmf;
+                if (!tree.Sample(point, normal, unit(gen), emitter, pmf))
+                {
+                    ++failures;
+                    continue;
+                }
+                ++counts[emitter];
+                CHECK(pmf == doctest::Approx(tree.PMF(point, normal, emitter)).epsilon(1e-9));
+            }
+
+            // Whatever PMF Leaves Over Is The Chance Of No Emitter Reaching point.
+            double total = (double)failures / samples;
+            for (uint32_t i = 0; i < (uint32_t)bounds.size(); ++i)
+            {
+                const double pmf = tree.PMF(point, normal, i);
+                const double expected = pmf * samples;
+                total += pmf;
+                CHECK(std::abs((double)counts[i] - expected) <= 5.0 * std::sqrt(expected) + 1.0);
+            }
+            CHECK(total == doctest::Approx(1.0).epsilon(0.01));
+        }
+    }
+
+    // LightList::PDF Of The Emitter A Ray Along A Light Sample Hits Is The Density That Sample Reported.
+    {
+        const auto emission = [](const double value) { return MakeRef<PureColorTexture2D>(Eigen::Vector3d{ value, value, value }); };
+        HittableList scene;
+        for (int i = 0; i < 16; ++i)
+        {
+            const Eigen::Vector3d origin{ position(gen), position(gen), position(gen) };
+            const Ref<Material> material = MakeRef<LambertMaterial>(emission(0.5), emission(i % 4 == 0 ? 0.0 : 1.0 + 10.0 * unit(gen)));
+            const Eigen::Vector3d u = (1.0 + unit(gen)) * RandomDirection(gen);
+            const Eigen::Vector3d v = (1.0 + unit(gen)) * RandomDirection(gen);
+            if (i % 2 == 0)
+            {
+                scene.PushBack(MakeRef<Quadrangle>(material, origin, u, v));
+            }
+            else
+            {
+                scene.PushBack(MakeRef<Triangle>(material, origin, u, v));
+            }
+        }
+
+        LightList lights;
+        lights.Append(scene);
+        lights.Build();
+        REQUIRE(lights.emitters.size() == 12);
+
+        int checked = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            const Eigen::Vector3d point{ position(gen), position(gen), position(gen) };
+            const Eigen::Vector3d normal = RandomDirection(gen);
+            LightList::LightSample sample;
+            if (!lights.Sample(point, normal, unit(gen), Eigen::Vector2d{ unit(gen), unit(gen) }, sample))
+            {
+                continue;
+            }
+
+            // Only The Sampled Point Itself, Nearer Emitters May Occlude It.
+            HitRecord record;
+            const Interval interval{ sample.distance * (1.0 - 1e-6), sample.distance * (1.0 + 1e-6) };
+            REQUIRE(scene.Hit(Ray(point, sample.omega), interval, record));
+            const int32_t emitter = lights.Find(record);
+            REQUIRE(emitter >= 0);
+            CHECK(lights.PDF(point, normal, emitter, sample.omega, record.t) == doctest::Approx(sample.pdf).epsilon(1e-6));
+            ++checked;
+        }
+        CHECK(checked > 10000);
+    }
+}
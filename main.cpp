@@ -17,11 +17,42 @@
 #include <Core/Debug.h>
 #include <Core/Mesh.h>
 #include <Core/Primitive.h>
+#include <Core/Light.h>
 #include <Core/ThreadPool.h>
 
 
-int main()
+#ifdef REAL_FLOAT
+    #define OUTPUT_NAME "OutputFloat.png"
+#else
+    #define OUTPUT_NAME "Output.png"
+#endif
+
+// Image Difference Check: PathTracer <reference.png> <image.png> [<noise.png>].
+// With A Second Render Of The Reference Build As <noise.png>, Fails Unless image Is Within The Monte Carlo Noise Of reference.
+// E.g. Output.png Twice From PathTracer Against OutputFloat.png From PathTracerFloat.
+int Compare(const int argc, char* argv[]) NOEXCEPT
+{
+    const Image reference = Image::From(argv[1]);
+    const double rmse = Image::RMSE(reference, Image::From(argv[2]));
+    fmt::print("RMSE: {:.6f} PSNR: {:.2f} dB\n", rmse, 20.0 * std::log10(1.0 / rmse));
+    if (argc < 4)
+    {
+        return EXIT_SUCCESS;
+    }
+
+    CONSTEXPR double tolerance = 1.25;
+    const double noise = Image::RMSE(reference, Image::From(argv[3]));
+    fmt::print("Noise RMSE: {:.6f} Ratio: {:.3f}\n", noise, rmse / noise);
+    return rmse <= tolerance * noise ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(const int argc, char* argv[])
 {
+    if (argc >= 3)
+    {
+        return Compare(argc, argv);
+    }
+
     // {
     //     fmt::print("Building BVH ...\n");
     //     const auto st = Debug::Now();
@@ -31,13 +62,15 @@ int main()
     // }
 
     const Ref<HittableList> scene = MakeRef<HittableList>();
+    LightList lights;
 
     Image film;
 
     const RenderConfig config
     {
         .SPP = 128 * (Eigen::Index)THREAD_POOL.ThreadNumber(),
-        .stop_prob = 0.02,
+        .stop_prob = (Real)0.02,
+        .target_error = (Real)0.0,
     };
 
     std::clog << "SPP: " << config.SPP << std::endl;
@@ -67,7 +100,12 @@ int main()
 
     // Test Scene 1. Veach Mis.
     const Camera camera = Camera::FromXML((FS::path(STR(CMAKE_SOURCE_DIR)) / "Input" / "veach-mis" / "veach-mis.xml").string().c_str());
+    const auto st = Debug::Now();
     const Ref<Mesh> mesh = MakeRef<Mesh>(Mesh::FromOBJ((FS::path(STR(CMAKE_SOURCE_DIR)) / "Input" / "veach-mis" / "veach-mis.obj").string().c_str(), camera.lights));
+    const auto ed = Debug::Now();
+    fmt::print("Load Mesh Done! Triangles: {} BVH Nodes: {} SAH Cost: {:.3f} BVH Bytes/Triangle: {:.1f} BVH Build: {} ms Time Escape: {} ms\n", mesh->triangles.size(), mesh->bvh.statistics.node_count, mesh->bvh.statistics.sah_cost, (double)mesh->bvh.MemoryUsage() / (double)mesh->triangles.size(), mesh->bvh.statistics.build_time / 1000, Debug::MilliSeconds(ed - st));
+    const Mesh::MemoryReport memory = mesh->Memory();
+    fmt::print("Mesh Memory (KB): Vertices: {} Normals: {} Texcoords: {} Triangles: {} Material Ids: {} Edges: {} BVH: {} Total: {} ({:.1f} Bytes/Triangle)\n", memory.vertices >> 10, memory.normals >> 10, memory.texcoords >> 10, memory.triangles >> 10, memory.material_ids >> 10, memory.edges >> 10, memory.bvh >> 10, memory.Total() >> 10, (double)memory.Total() / (double)mesh->triangles.size());
     scene->PushBack(mesh);
 
     // Test Scene 2. Cornell Box.
@@ -80,17 +118,24 @@ int main()
     // const Ref<Mesh> mesh = MakeRef<Mesh>(Mesh::FromOBJ((FS::path(STR(CMAKE_SOURCE_DIR)) / "Input" / "bathroom2" / "bathroom2.obj").string().c_str(), camera.lights));
     // scene->PushBack(mesh);
 
+    // Optional HDR Environment, Lights Rays Leaving The Scene.
+    // lights.environment = EnvironmentLight::From((FS::path(STR(CMAKE_SOURCE_DIR)) / "Input" / "environment.hdr").string().c_str(), 1.0);
+
+    lights.Append(*scene);
+    lights.Build();
+    fmt::print("Lights: {} Emitters Light Tree Nodes: {} Environment: {}\n", lights.emitters.size(), lights.tree.nodes.size(), !lights.environment.IsEmpty());
+
     {   // Render To Image
         fmt::print("Rendering...\n");
         const auto st = Debug::Now();
-        Renderer::Render(camera, scene, {}, config, film);
+        Renderer::Render(camera, scene, lights, config, film);
         const auto ed = Debug::Now();
         fmt::print("Render Done! Time Escape: {} ms\n", Debug::MilliSeconds(ed - st));
     }
 
     {   // Write Image To Disk.
-        fmt::print("Writing To Disk {}\n", (FS::path(STR(CMAKE_SOURCE_DIR)) / "Output" / "Output.png").string().c_str());
-        const bool result = Image::ToPNG(film, (FS::path(STR(CMAKE_SOURCE_DIR)) / "Output" / "Output.png").string().c_str());
+        fmt::print("Writing To Disk {}\n", (FS::path(STR(CMAKE_SOURCE_DIR)) / "Output" / OUTPUT_NAME).string().c_str());
+        const bool result = Image::ToPNG(film, (FS::path(STR(CMAKE_SOURCE_DIR)) / "Output" / OUTPUT_NAME).string().c_str());
         ASSERT(result);
         fmt::print("Write To Disk Done!\n");
     }